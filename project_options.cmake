@@ -28,11 +28,13 @@ if (PROJECT_IS_TOP_LEVEL)
     option(lib2k_enable_undefined_behavior_sanitizer "Enable undefined behavior sanitizer" ${supports_ubsan})
     option(lib2k_enable_address_sanitizer "Enable address sanitizer" ${supports_asan})
     option(lib2k_build_tests "Build tests using Google Test" ON)
+    option(lib2k_enable_simd "Enable SIMD kernels (selected at runtime based on the CPU)" ON)
 else ()
     option(lib2k_warnings_as_errors "Treat warnings as errors" OFF)
     option(lib2k_enable_undefined_behavior_sanitizer "Enable undefined behavior sanitizer" OFF)
     option(lib2k_enable_address_sanitizer "Enable address sanitizer" OFF)
     option(lib2k_build_tests "Build tests using Google Test" OFF)
+    option(lib2k_enable_simd "Enable SIMD kernels (selected at runtime based on the CPU)" ON)
 endif ()
 
 add_library(lib2k_warnings INTERFACE)
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "utf8/string.hpp"
+#include "utf8/string_view.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace c2k {
+    struct PatternMatch final {
+        std::size_t pattern_index;
+        // position and length in bytes
+        std::size_t offset;
+        std::size_t length;
+
+        [[nodiscard]] bool operator==(PatternMatch const& other) const = default;
+    };
+
+    // Finds the occurrences of any of a set of patterns in a single pass over the text (using an Aho-Corasick
+    // automaton), e.g. to redact a list of sensitive tokens without scanning the text once per token.
+    // Matches never overlap: the match that starts first wins, and of the matches that start at the same
+    // position, the longest one wins. Since a matcher is immutable once it is constructed, it can be shared
+    // between threads.
+    class MultiPatternMatcher final {
+    private:
+        static constexpr auto no_match = std::uint32_t{ 0xFFFF'FFFF };
+
+        std::vector<std::string> m_patterns;
+        std::vector<std::string> m_replacements;
+        // bytes that do not occur in any pattern share class 0
+        std::array<std::uint16_t, 256> m_byte_classes{};
+        std::size_t m_num_byte_classes{ 1 };
+        // the complete transition table of the automaton (indexed by state * m_num_byte_classes + byte class)
+        std::vector<std::uint32_t> m_transitions;
+        // the length of the longest pattern prefix that each state represents
+        std::vector<std::uint32_t> m_depths;
+        // the index of the longest pattern that ends in each state (or no_match)
+        std::vector<std::uint32_t> m_matches;
+        bool m_is_utf8{ true };
+
+    public:
+        // Throws std::invalid_argument if any of the patterns is empty. If a pattern is contained multiple
+        // times, matches report the index of its first occurrence.
+        explicit MultiPatternMatcher(std::vector<std::string> patterns);
+        // Pairs of patterns and the replacements that replace_all() substitutes for them.
+        explicit MultiPatternMatcher(std::vector<std::pair<std::string, std::string>> patterns_and_replacements);
+
+        [[nodiscard]] std::size_t num_patterns() const {
+            return m_patterns.size();
+        }
+
+        [[nodiscard]] std::string_view pattern(std::size_t const index) const {
+            return m_patterns.at(index);
+        }
+
+        // To search within UTF-8 strings, pass their view(). If all patterns are valid UTF-8, all matches
+        // start and end at char boundaries.
+        [[nodiscard]] std::vector<PatternMatch> find_all(std::string_view text) const;
+        [[nodiscard]] bool contains_any(std::string_view text) const;
+
+        // The result is allocated once with its final size. Throws std::logic_error if the matcher has been
+        // constructed without replacements.
+        [[nodiscard]] std::string replace_all(std::string_view text) const;
+
+        [[nodiscard]] std::string replace_all(std::string const& text) const {
+            return replace_all(std::string_view{ text });
+        }
+
+        [[nodiscard]] std::string replace_all(char const* const text) const {
+            return replace_all(std::string_view{ text });
+        }
+
+        // Throws InvalidUtf8String if the patterns or replacements are not valid UTF-8 and the result isn't either.
+        [[nodiscard]] Utf8String replace_all(Utf8StringView text) const;
+
+    private:
+        void build();
+        [[nodiscard]] std::uint32_t transition(std::uint32_t state, char byte) const;
+
+        template<typename Callback>
+        void for_each_match(std::string_view text, Callback&& callback) const;
+    };
+} // namespace c2k
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cctype>
 #include <charconv>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <iterator>
 #include <limits>
 #include <optional>
+#include <ranges>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -271,8 +276,324 @@ namespace c2k {
         return result;
     }
 
+    namespace detail {
+        // Range over the parts of a string that are separated by a (non-empty) delimiter. Nothing is allocated
+        // and the next delimiter is only searched for when the iterator is advanced. `Traits` provides the
+        // search (`find(haystack, needle, start)`) and converts each part into a `Traits::Part`.
+        template<typename Traits>
+        class BasicSplitView final : public std::ranges::view_interface<BasicSplitView<Traits>> {
+        public:
+            using Part = typename Traits::Part;
+
+            class Iterator final {
+                friend class BasicSplitView;
+
+            private:
+                static constexpr auto end_position = std::string_view::npos;
+
+                std::string_view m_source;
+                std::string_view m_delimiter;
+                std::size_t m_part_start{ end_position };
+                std::size_t m_part_end{ end_position };
+
+                Iterator(std::string_view const source, std::string_view const delimiter, std::size_t const part_start)
+                    : m_source{ source },
+                      m_delimiter{ delimiter },
+                      m_part_start{ part_start },
+                      m_part_end{ part_start == end_position ? end_position : find_part_end() } { }
+
+            public:
+                using difference_type = std::ptrdiff_t;
+                using value_type = Part;
+
+                Iterator() = default;
+
+                [[nodiscard]] Part operator*() const {
+                    return Traits::make_part(m_source.substr(m_part_start, m_part_end - m_part_start));
+                }
+
+                Iterator& operator++() {
+                    if (m_part_end == m_source.size()) {
+                        m_part_start = end_position;
+                        m_part_end = end_position;
+                    } else {
+                        m_part_start = m_part_end + m_delimiter.size();
+                        m_part_end = find_part_end();
+                    }
+                    return *this;
+                }
+
+                [[nodiscard]] Iterator operator++(int) {
+                    auto const result = *this;
+                    ++(*this);
+                    return result;
+                }
+
+                [[nodiscard]] bool operator==(Iterator const& other) const {
+                    return m_part_start == other.m_part_start;
+                }
+
+            private:
+                [[nodiscard]] std::size_t find_part_end() const {
+                    auto const position = Traits::find(m_source, m_delimiter, m_part_start);
+                    return position == std::string_view::npos ? m_source.size() : position;
+                }
+            };
+
+        private:
+            std::string_view m_source;
+            std::string_view m_delimiter;
+
+        public:
+            BasicSplitView() = default;
+
+            BasicSplitView(std::string_view const source, std::string_view const delimiter)
+                : m_source{ source },
+                  m_delimiter{ delimiter } {
+                if (delimiter.empty()) {
+                    throw std::invalid_argument{ "cannot split string with empty delimiter" };
+                }
+            }
+
+            [[nodiscard]] Iterator begin() const {
+                return Iterator{ m_source, m_delimiter, 0 };
+            }
+
+            [[nodiscard]] Iterator end() const {
+                return Iterator{ m_source, m_delimiter, Iterator::end_position };
+            }
+        };
+
+        struct StringViewSplitTraits final {
+            using Part = std::string_view;
+
+            [[nodiscard]] static std::string_view make_part(std::string_view const part) {
+                return part;
+            }
+
+            // clang-format off
+            [[nodiscard]] static std::size_t find(
+                std::string_view const haystack,
+                std::string_view const needle,
+                std::size_t const start
+            ) { // clang-format on
+                return haystack.find(needle, start);
+            }
+        };
+    } // namespace detail
+
+    using SplitView = detail::BasicSplitView<detail::StringViewSplitTraits>;
+
     [[nodiscard]] std::vector<std::string> split(std::string const& s, std::string_view delimiter);
 
+    // The parts refer to `s`, which therefore has to outlive the returned view.
+    [[nodiscard]] inline SplitView split_view(std::string_view const s, std::string_view const delimiter) {
+        return SplitView{ s, delimiter };
+    }
+
+    // Replace the contents of `result` with the parts of `s`. The capacity of `result` (and, in case of
+    // std::string parts, the capacities of its elements) is reused.
+    void split_into(std::string_view s, std::string_view delimiter, std::vector<std::string_view>& result);
+    void split_into(std::string_view s, std::string_view delimiter, std::vector<std::string>& result);
+
+    // Set of bytes that can be searched for with SIMD instructions. Besides one bit per byte, the set keeps two
+    // lookup tables that classify bytes by their low and high nibble (see simd::NibbleTables). The tables are
+    // exact for sets of ASCII bytes. Otherwise, they may report false positives that have to be filtered out.
+    class ByteSet final {
+    private:
+        std::array<std::uint64_t, 4> m_bits{};
+        std::array<std::uint8_t, 16> m_low_nibble_table{};
+        std::array<std::uint8_t, 16> m_high_nibble_table{};
+
+    public:
+        constexpr ByteSet() = default;
+
+        constexpr explicit ByteSet(std::string_view const bytes) {
+            for (auto const byte : bytes) {
+                insert(byte);
+            }
+        }
+
+        constexpr void insert(char const c) {
+            auto const byte = static_cast<std::uint8_t>(c);
+            m_bits[byte / 64] |= std::uint64_t{ 1 } << (byte % 64);
+            auto const bucket = static_cast<std::uint8_t>(1U << ((byte >> 4) & 0b111));
+            m_low_nibble_table[byte & 0x0F] |= bucket;
+            m_high_nibble_table[byte >> 4] = bucket;
+        }
+
+        [[nodiscard]] constexpr bool contains(char const c) const {
+            auto const byte = static_cast<std::uint8_t>(c);
+            return (m_bits[byte / 64] & (std::uint64_t{ 1 } << (byte % 64))) != 0;
+        }
+
+        [[nodiscard]] constexpr bool is_empty() const {
+            return m_bits == std::array<std::uint64_t, 4>{};
+        }
+
+        [[nodiscard]] constexpr std::array<std::uint8_t, 16> const& low_nibble_table() const {
+            return m_low_nibble_table;
+        }
+
+        [[nodiscard]] constexpr std::array<std::uint8_t, 16> const& high_nibble_table() const {
+            return m_high_nibble_table;
+        }
+
+        [[nodiscard]] constexpr bool operator==(ByteSet const& other) const {
+            return m_bits == other.m_bits;
+        }
+    };
+
+    // Position (in bytes) of a token within the tokenized string.
+    struct TokenSpan final {
+        std::size_t offset;
+        std::size_t length;
+
+        [[nodiscard]] bool operator==(TokenSpan const& other) const = default;
+    };
+
+    namespace detail {
+        // Returns the position of the first byte at or after `start` that is contained in `set`, or
+        // std::string_view::npos.
+        [[nodiscard]] std::size_t find_first_in_set(std::string_view s, std::size_t start, ByteSet const& set);
+
+        // Range over the tokens of a string, i.e. the (non-empty) runs of bytes between delimiters. Consecutive
+        // delimiters are skipped. The next token is only searched for when the iterator is advanced.
+        // `Delimiters` provides `match_length(s, position)` (the length of the delimiter at `position` or 0),
+        // `find(s, start)` (the position of the next delimiter or npos) and converts tokens into a `Token`.
+        template<typename Delimiters>
+        class BasicTokenView final : public std::ranges::view_interface<BasicTokenView<Delimiters>> {
+        public:
+            using Token = typename Delimiters::Token;
+
+            class Iterator final {
+                friend class BasicTokenView;
+
+            private:
+                static constexpr auto end_position = std::string_view::npos;
+
+                std::string_view m_source;
+                Delimiters const* m_delimiters{ nullptr };
+                std::size_t m_token_start{ end_position };
+                std::size_t m_token_end{ end_position };
+
+                Iterator(std::string_view const source, Delimiters const& delimiters, std::size_t const position)
+                    : m_source{ source },
+                      m_delimiters{ &delimiters } {
+                    advance_to_token(position);
+                }
+
+            public:
+                using difference_type = std::ptrdiff_t;
+                using value_type = Token;
+
+                Iterator() = default;
+
+                [[nodiscard]] Token operator*() const {
+                    return Delimiters::make_token(m_source.substr(m_token_start, m_token_end - m_token_start));
+                }
+
+                [[nodiscard]] TokenSpan span() const {
+                    return TokenSpan{ m_token_start, m_token_end - m_token_start };
+                }
+
+                Iterator& operator++() {
+                    advance_to_token(m_token_end);
+                    return *this;
+                }
+
+                [[nodiscard]] Iterator operator++(int) {
+                    auto const result = *this;
+                    ++(*this);
+                    return result;
+                }
+
+                [[nodiscard]] bool operator==(Iterator const& other) const {
+                    return m_token_start == other.m_token_start;
+                }
+
+            private:
+                void advance_to_token(std::size_t position) {
+                    if (position >= m_source.size()) {
+                        m_token_start = end_position;
+                        m_token_end = end_position;
+                        return;
+                    }
+                    // delimiters usually come alone, so skipping them does not pay off for SIMD
+                    for (auto length = m_delimiters->match_length(m_source, position); length > 0;
+                         length = m_delimiters->match_length(m_source, position)) {
+                        position += length;
+                        if (position == m_source.size()) {
+                            m_token_start = end_position;
+                            m_token_end = end_position;
+                            return;
+                        }
+                    }
+                    m_token_start = position;
+                    auto const token_end = m_delimiters->find(m_source, position);
+                    m_token_end = token_end == std::string_view::npos ? m_source.size() : token_end;
+                }
+            };
+
+        private:
+            std::string_view m_source;
+            Delimiters m_delimiters;
+
+        public:
+            BasicTokenView() = default;
+
+            BasicTokenView(std::string_view const source, Delimiters delimiters)
+                : m_source{ source },
+                  m_delimiters{ std::move(delimiters) } { }
+
+            [[nodiscard]] Iterator begin() const {
+                return Iterator{ m_source, m_delimiters, 0 };
+            }
+
+            [[nodiscard]] Iterator end() const {
+                return Iterator{ m_source, m_delimiters, Iterator::end_position };
+            }
+
+            // Replaces the contents of `result` (but keeps its capacity).
+            void spans_into(std::vector<TokenSpan>& result) const {
+                result.clear();
+                for (auto it = begin(); it != end(); ++it) {
+                    result.push_back(it.span());
+                }
+            }
+        };
+
+        struct ByteSetDelimiters final {
+            using Token = std::string_view;
+
+            ByteSet set;
+
+            [[nodiscard]] static std::string_view make_token(std::string_view const token) {
+                return token;
+            }
+
+            [[nodiscard]] std::size_t match_length(std::string_view const s, std::size_t const position) const {
+                return set.contains(s[position]) ? 1 : 0;
+            }
+
+            [[nodiscard]] std::size_t find(std::string_view const s, std::size_t const start) const {
+                return find_first_in_set(s, start, set);
+            }
+        };
+    } // namespace detail
+
+    // The iterators of a token view refer to the view itself, which therefore has to outlive them.
+    using TokenView = detail::BasicTokenView<detail::ByteSetDelimiters>;
+
+    // Splits `s` at every byte that is contained in `delimiters` and skips empty tokens (so that, e.g.,
+    // "a, b" results in "a" and "b" if both ',' and ' ' are delimiters). The tokens refer to `s`.
+    [[nodiscard]] inline TokenView tokenize(std::string_view const s, ByteSet const& delimiters) {
+        return TokenView{ s, detail::ByteSetDelimiters{ delimiters } };
+    }
+
+    // Replaces the contents of `result` with the positions of the tokens (see tokenize()).
+    void tokenize_into(std::string_view s, ByteSet const& delimiters, std::vector<TokenSpan>& result);
+
     [[nodiscard]] std::string join(StringIterable auto&& iterable, std::string_view const separator) {
         auto result = std::string{};
         for (auto it = std::cbegin(iterable); it != std::cend(iterable); ++it) {
@@ -437,3 +758,12 @@ namespace c2k {
         return result;
     }
 } // namespace c2k
+
+template<typename Traits>
+inline constexpr bool std::ranges::enable_borrowed_range<c2k::detail::BasicSplitView<Traits>> = true;
+
+static_assert(std::forward_iterator<c2k::SplitView::Iterator>);
+static_assert(std::ranges::view<c2k::SplitView>);
+static_assert(std::ranges::borrowed_range<c2k::SplitView>);
+static_assert(std::forward_iterator<c2k::TokenView::Iterator>);
+static_assert(std::ranges::view<c2k::TokenView>);
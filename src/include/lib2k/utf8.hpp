@@ -2,5 +2,16 @@
 
 #include "utf8/char.hpp"
 #include "utf8/errors.hpp"
+#include "utf8/graphemes.hpp"
+#include "utf8/inline_string.hpp"
+#include "utf8/interner.hpp"
+#include "utf8/normalization.hpp"
+#include "utf8/pmr_string.hpp"
+#include "utf8/ranges.hpp"
+#include "utf8/rope.hpp"
+#include "utf8/searcher.hpp"
+#include "utf8/stream_validator.hpp"
 #include "utf8/string.hpp"
+#include "utf8/string_builder.hpp"
 #include "utf8/string_view.hpp"
+#include "utf8/transcoding.hpp"
@@ -1,12 +1,14 @@
 #pragma once
 
-#include "../static_vector.hpp"
 #include "errors.hpp"
+#include "ranges.hpp"
+#include <array>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
 #include <span>
 #include <tl/expected.hpp>
+#include <type_traits>
 
 namespace c2k {
 
@@ -20,16 +22,30 @@ namespace c2k {
         friend class Utf8StringView;
 
     private:
-        using Codepoint = StaticVector<std::byte, 4>;
+        // The number of used bytes is determined by the lead byte. Unused bytes are always zero, which
+        // allows for the defaulted comparison operator.
+        using Bytes = std::array<std::byte, 4>;
 
-        Codepoint m_codepoint;
+        Bytes m_bytes{};
 
-        explicit constexpr Utf8Char(Codepoint const codepoint) : m_codepoint{ codepoint } { }
+        [[nodiscard]] constexpr std::size_t num_bytes() const {
+            return detail::utf8_sequence_lengths[static_cast<std::uint8_t>(m_bytes.front())];
+        }
+
+        [[nodiscard]] constexpr std::span<std::byte const> bytes() const {
+            return std::span{ m_bytes.data(), num_bytes() };
+        }
 
     public:
-        constexpr Utf8Char() : m_codepoint{ std::byte{ 0 } } { }
+        constexpr Utf8Char() = default;
+
+        constexpr Utf8Char(char const c) // NOLINT (implicit converting constructor)
+            : m_bytes{ static_cast<std::byte>(c) } {
+            if (static_cast<unsigned char>(c) >= 0x80) {
+                throw InvalidUtf8Char{};
+            }
+        }
 
-        Utf8Char(char c); // NOLINT (implicit converting constructor)
         Utf8Char(Utf8Char const&) = default;
         Utf8Char(Utf8Char&&) = default;
         Utf8Char& operator=(Utf8Char const&) & = default;
@@ -40,23 +56,22 @@ namespace c2k {
 
         [[nodiscard]] static constexpr Utf8Char from_bytes_unchecked(std::span<std::byte const> const bytes) {
             assert(not bytes.empty());
-            assert(bytes.size_bytes() <= Codepoint::capacity());
-            auto codepoint = Codepoint{};
-            for (auto const byte : bytes) {
-                codepoint.push_back(byte);
+            assert(bytes.size_bytes() <= std::tuple_size_v<Bytes>);
+            auto result = Utf8Char{};
+            for (auto i = std::size_t{ 0 }; i < bytes.size(); ++i) {
+                result.m_bytes[i] = bytes[i];
             }
-            return Utf8Char{ codepoint };
+            assert(result.num_bytes() == bytes.size());
+            return result;
         }
 
         [[nodiscard]] static tl::expected<Utf8Char, Utf8Error> from_bytes(std::span<std::byte const> bytes);
 
+        // Fails for surrogates and values outside of the Unicode code space.
         [[nodiscard]] static tl::expected<Utf8Char, Utf8Error> from_codepoint(std::int32_t codepoint);
 
         [[nodiscard]] std::string_view as_string_view() const {
-            return std::string_view{
-                reinterpret_cast<char const*>(m_codepoint.data()),
-                reinterpret_cast<char const*>(m_codepoint.data() + m_codepoint.size()),
-            };
+            return std::string_view{ reinterpret_cast<char const*>(m_bytes.data()), num_bytes() };
         }
 
         [[nodiscard]] std::int32_t codepoint() const;
@@ -69,13 +84,13 @@ namespace c2k {
         [[nodiscard]] Utf8Char to_lowercase() const;
 
         friend std::ostream& operator<<(std::ostream& os, Utf8Char const c) {
-            for (auto const byte : c.m_codepoint) {
-                os << static_cast<unsigned char>(byte);
-            }
-            return os;
+            return os << c.as_string_view();
         }
     };
 
+    static_assert(sizeof(Utf8Char) == 4);
+    static_assert(std::is_trivially_copyable_v<Utf8Char>);
+
     namespace Utf8Literals {
         [[nodiscard]] Utf8Char operator""_utf8(char c);
     };
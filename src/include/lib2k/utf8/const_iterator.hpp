@@ -8,6 +8,8 @@
 namespace c2k {
     class Utf8String;
     class Utf8StringView;
+    template<std::size_t inline_capacity>
+    class InlineUtf8String;
 
     namespace detail {
         class Utf8ConstReverseIterator;
@@ -15,6 +17,8 @@ namespace c2k {
         class Utf8ConstIterator final {
             friend class ::c2k::Utf8String;
             friend class ::c2k::Utf8StringView;
+            template<std::size_t inline_capacity>
+            friend class ::c2k::InlineUtf8String;
             friend class ::c2k::detail::Utf8ConstReverseIterator;
 
         private:
@@ -7,6 +7,8 @@ namespace c2k {
         InvalidUtf8String,
         InvalidUtf8Char,
         InvalidBytesRange,
+        InvalidUtf16String,
+        InvalidUtf32String,
     };
 
     class InvalidUtf8Char final : public std::runtime_error {
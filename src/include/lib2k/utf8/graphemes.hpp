@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <string_view>
+
+namespace c2k {
+    class Utf8String;
+    class Utf8StringView;
+
+    // Incremental grapheme cluster segmentation (as implemented by utf8proc). The code points of a text
+    // are fed one after another. Since the breaker keeps all of its state between calls, the text can be
+    // split into arbitrary chunks (as long as no code point is split).
+    class Utf8GraphemeBreaker final {
+    private:
+        std::int32_t m_state{ 0 };
+        char32_t m_previous{ 0 };
+        bool m_has_previous{ false };
+
+    public:
+        // Returns whether a grapheme cluster starts with `codepoint`. This is always the case for the
+        // first code point after construction or after calling reset().
+        [[nodiscard]] bool is_break_before(char32_t codepoint);
+
+        // Feeds all code points of the (valid UTF-8) `chunk` and returns the byte offset of the last grapheme
+        // cluster that starts within it. Everything before that offset (and before the chunk) consists of
+        // complete grapheme clusters. Returns std::nullopt if the chunk only continues a previous cluster.
+        [[nodiscard]] std::optional<std::size_t> find_last_break(std::string_view chunk);
+
+        void reset() {
+            *this = Utf8GraphemeBreaker{};
+        }
+    };
+
+    namespace detail {
+        class Utf8GraphemeIterator final {
+            friend class Utf8GraphemeRange;
+
+        private:
+            std::byte const* m_cluster_start{ nullptr };
+            std::byte const* m_cluster_end{ nullptr };
+            std::byte const* m_end{ nullptr };
+            // has already been fed with the first code point of the next cluster
+            Utf8GraphemeBreaker m_breaker;
+
+            Utf8GraphemeIterator(std::byte const* start, std::byte const* end);
+
+            void find_cluster_end();
+
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = Utf8StringView;
+
+            Utf8GraphemeIterator() = default;
+
+            [[nodiscard]] Utf8StringView operator*() const;
+            Utf8GraphemeIterator& operator++();
+            [[nodiscard]] Utf8GraphemeIterator operator++(int);
+
+            [[nodiscard]] bool operator==(Utf8GraphemeIterator const& other) const {
+                return m_cluster_start == other.m_cluster_start;
+            }
+        };
+
+        // Range over the grapheme clusters of a validated UTF-8 string. Iterating does not allocate and
+        // visits every code point only once.
+        class Utf8GraphemeRange final : public std::ranges::view_interface<Utf8GraphemeRange> {
+            friend class ::c2k::Utf8String;
+            friend class ::c2k::Utf8StringView;
+
+        private:
+            std::string_view m_data;
+
+            explicit Utf8GraphemeRange(std::string_view const data) : m_data{ data } { }
+
+        public:
+            Utf8GraphemeRange() = default;
+
+            [[nodiscard]] Utf8GraphemeIterator begin() const;
+            [[nodiscard]] Utf8GraphemeIterator end() const;
+        };
+    } // namespace detail
+
+    using Utf8GraphemeRange = detail::Utf8GraphemeRange;
+} // namespace c2k
+
+template<>
+inline constexpr bool std::ranges::enable_borrowed_range<c2k::detail::Utf8GraphemeRange> = true;
@@ -0,0 +1,447 @@
+#pragma once
+
+#include "char.hpp"
+#include "errors.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+#include <utility>
+#include <vector>
+
+namespace c2k {
+    // UTF-8 string that stores up to `inline_capacity` bytes within the object itself (instead of relying on
+    // the small string optimization of std::string, which usually only covers 15 bytes). Longer strings are
+    // moved to the heap. The read-only operations are those of Utf8StringView, to which this class converts
+    // without copying. Apart from that, it provides the operations of Utf8String except for the char index,
+    // reserve(), reverse(), normalize() and transform_in_place(). Use to_string() for those.
+    template<std::size_t inline_capacity>
+    class InlineUtf8String final {
+    private:
+        struct HeapBuffer final {
+            // null-terminated
+            char* data;
+            // not including the null terminator
+            std::size_t capacity;
+        };
+
+        // The data (and a null terminator) is stored in `m_inline` as long as it fits, i.e. as long as `m_size`
+        // does not exceed `inline_capacity`. Otherwise, `m_heap` is the active member.
+        union {
+            std::array<char, inline_capacity + 1> m_inline{};
+            HeapBuffer m_heap;
+        };
+        std::size_t m_size{ 0 };
+        // see Utf8String::m_is_ascii
+        bool m_is_ascii{ true };
+
+    public:
+        using ConstIterator = detail::Utf8ConstIterator;
+        using ReverseIterator = detail::Utf8ConstReverseIterator;
+
+        InlineUtf8String() = default;
+
+        InlineUtf8String(Utf8StringView const view) { // NOLINT (implicit converting constructor)
+            append(view);
+        }
+
+        InlineUtf8String(Utf8String const& string) // NOLINT (implicit converting constructor)
+            : InlineUtf8String{ Utf8StringView{ string } } { }
+
+        InlineUtf8String(std::string_view const chars) // NOLINT (implicit converting constructor)
+            : InlineUtf8String{ Utf8StringView{ chars } } { }
+
+        InlineUtf8String(std::string const& chars) // NOLINT (implicit converting constructor)
+            : InlineUtf8String{ Utf8StringView{ chars } } { }
+
+        InlineUtf8String(char const* const chars) // NOLINT (implicit converting constructor)
+            : InlineUtf8String{ Utf8StringView{ chars } } { }
+
+        InlineUtf8String(InlineUtf8String const& other) {
+            append_unchecked(other.view(), other.m_is_ascii);
+        }
+
+        InlineUtf8String(InlineUtf8String&& other) noexcept {
+            take_over(other);
+        }
+
+        InlineUtf8String& operator=(InlineUtf8String const& other) {
+            if (this == &other) {
+                return *this;
+            }
+            auto copy = other;
+            return *this = std::move(copy);
+        }
+
+        InlineUtf8String& operator=(InlineUtf8String&& other) noexcept {
+            if (this == &other) {
+                return *this;
+            }
+            clear();
+            take_over(other);
+            return *this;
+        }
+
+        ~InlineUtf8String() {
+            clear();
+        }
+
+        [[nodiscard]] static tl::expected<InlineUtf8String, Utf8Error> from_chars(std::string_view const chars) {
+            if (not Utf8String::is_valid_utf8(chars)) {
+                return tl::unexpected{ Utf8Error::InvalidUtf8String };
+            }
+            return InlineUtf8String{ Utf8StringView::from_string_view_unchecked(chars) };
+        }
+
+        [[nodiscard]] static constexpr std::size_t max_inline_size() {
+            return inline_capacity;
+        }
+
+        [[nodiscard]] bool is_inline() const {
+            return m_size <= inline_capacity;
+        }
+
+        [[nodiscard]] bool is_ascii() const {
+            return as_view().is_ascii();
+        }
+
+        [[nodiscard]] char const* c_str() const {
+            return is_inline() ? m_inline.data() : m_heap.data;
+        }
+
+        [[nodiscard]] std::string_view view() const {
+            return std::string_view{ c_str(), m_size };
+        }
+
+        [[nodiscard]] Utf8StringView as_view() const {
+            auto result = Utf8StringView::from_string_view_unchecked(view());
+            result.m_is_ascii = m_is_ascii;
+            return result;
+        }
+
+        operator Utf8StringView() const { // NOLINT (implicit conversion operator)
+            return as_view();
+        }
+
+        [[nodiscard]] Utf8String to_string() const {
+            return Utf8String::from_validated_string(std::string{ view() }, m_is_ascii);
+        }
+
+        [[nodiscard]] std::size_t num_bytes() const {
+            return m_size;
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_size == 0;
+        }
+
+        [[nodiscard]] bool is_not_empty() const {
+            return not is_empty();
+        }
+
+        [[nodiscard]] std::size_t calculate_char_count() const {
+            return as_view().calculate_char_count();
+        }
+
+        [[nodiscard]] std::size_t calculate_char_width() const {
+            return as_view().calculate_char_width();
+        }
+
+        [[nodiscard]] Utf8Char front() const {
+            return as_view().front();
+        }
+
+        [[nodiscard]] Utf8Char back() const {
+            return as_view().back();
+        }
+
+        [[nodiscard]] ConstIterator begin() const {
+            return as_view().begin();
+        }
+
+        [[nodiscard]] ConstIterator cbegin() const {
+            return begin();
+        }
+
+        [[nodiscard]] ConstIterator end() const {
+            return as_view().end();
+        }
+
+        [[nodiscard]] ConstIterator cend() const {
+            return end();
+        }
+
+        [[nodiscard]] ReverseIterator rbegin() const {
+            return as_view().rbegin();
+        }
+
+        [[nodiscard]] ReverseIterator crbegin() const {
+            return rbegin();
+        }
+
+        [[nodiscard]] ReverseIterator rend() const {
+            return as_view().rend();
+        }
+
+        [[nodiscard]] ReverseIterator crend() const {
+            return rend();
+        }
+
+        [[nodiscard]] Utf8CodepointRange codepoints() const {
+            return as_view().codepoints();
+        }
+
+        [[nodiscard]] Utf8CharSpanRange char_spans() const {
+            return as_view().char_spans();
+        }
+
+        [[nodiscard]] Utf8GraphemeRange graphemes() const {
+            return as_view().graphemes();
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8Char const needle) const {
+            return as_view().find(needle);
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8Char const needle, ConstIterator const& start) const {
+            return as_view().find(needle, start);
+        }
+
+        // clang-format off
+        [[nodiscard]] ConstIterator find(
+            Utf8Char const needle,
+            ConstIterator::difference_type const start_position
+        ) const { // clang-format on
+            return as_view().find(needle, start_position);
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8StringView const needle) const {
+            return as_view().find(needle);
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8StringView const needle, ConstIterator const& start) const {
+            return as_view().find(needle, start);
+        }
+
+        // clang-format off
+        [[nodiscard]] ConstIterator find(
+            Utf8StringView const needle,
+            ConstIterator::difference_type const start_position
+        ) const { // clang-format on
+            return as_view().find(needle, start_position);
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8Searcher const& searcher) const {
+            return as_view().find(searcher);
+        }
+
+        [[nodiscard]] std::vector<Utf8StringView> split(Utf8StringView const delimiter) const {
+            return as_view().split(delimiter);
+        }
+
+        [[nodiscard]] InlineUtf8String substring(std::size_t const start, std::size_t const num_chars) const {
+            return InlineUtf8String{ as_view().substring(start, num_chars) };
+        }
+
+        [[nodiscard]] InlineUtf8String substring(std::size_t const start) const {
+            return InlineUtf8String{ as_view().substring(start) };
+        }
+
+        [[nodiscard]] bool operator==(Utf8StringView const other) const {
+            return view() == other.view();
+        }
+
+        [[nodiscard]] bool operator==(Utf8String const& other) const {
+            return view() == other.view();
+        }
+
+        [[nodiscard]] bool operator==(char const* const other) const {
+            return *this == Utf8StringView{ other };
+        }
+
+        [[nodiscard]] InlineUtf8String to_uppercase() const {
+            return InlineUtf8String{ as_view().to_uppercase() };
+        }
+
+        [[nodiscard]] InlineUtf8String to_lowercase() const {
+            return InlineUtf8String{ as_view().to_lowercase() };
+        }
+
+        void make_uppercase() {
+            *this = to_uppercase();
+        }
+
+        void make_lowercase() {
+            *this = to_lowercase();
+        }
+
+        // clang-format off
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8StringView const to_replace,
+            Utf8StringView const replacement,
+            ConstIterator const& start,
+            MaxReplacementCount const max_num_replacements
+        ) const { // clang-format on
+            return InlineUtf8String{ as_view().replace(to_replace, replacement, start, max_num_replacements) };
+        }
+
+        // clang-format off
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8StringView const to_replace,
+            Utf8StringView const replacement
+        ) const {
+            return InlineUtf8String{ as_view().replace(to_replace, replacement) };
+        }
+
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8StringView const to_replace,
+            Utf8StringView const replacement,
+            ConstIterator const& start
+        ) const {
+            return InlineUtf8String{ as_view().replace(to_replace, replacement, start) };
+        }
+
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8StringView const to_replace,
+            Utf8StringView const replacement,
+            MaxReplacementCount const max_num_replacements
+        ) const {
+            return InlineUtf8String{ as_view().replace(to_replace, replacement, max_num_replacements) };
+        }
+
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8Searcher const& to_replace,
+            Utf8StringView const replacement
+        ) const {
+            return InlineUtf8String{ as_view().replace(to_replace, replacement) };
+        }
+
+        [[nodiscard]] InlineUtf8String replace(
+            Utf8Searcher const& to_replace,
+            Utf8StringView const replacement,
+            MaxReplacementCount const max_num_replacements
+        ) const { // clang-format on
+            return InlineUtf8String{ as_view().replace(to_replace, replacement, max_num_replacements) };
+        }
+
+        void clear() {
+            if (not is_inline()) {
+                delete[] m_heap.data;
+            }
+            m_inline = {};
+            m_size = 0;
+            m_is_ascii = true;
+        }
+
+        ConstIterator erase(ConstIterator const& position) {
+            return erase(position, std::next(position));
+        }
+
+        // Moves the data back into the object if it fits inline afterwards.
+        ConstIterator erase(ConstIterator const& first, ConstIterator const& last) {
+            auto const start = byte_offset(first);
+            auto const end = byte_offset(last);
+            auto const data = is_inline() ? m_inline.data() : m_heap.data;
+            // including the null terminator
+            std::copy(data + end, data + m_size + 1, data + start);
+            auto const erased_until_end = (end == m_size);
+            auto const new_size = m_size - (end - start);
+            if (not is_inline() and new_size <= inline_capacity) {
+                auto const heap = m_heap;
+                m_inline = {};
+                std::copy(heap.data, heap.data + new_size, m_inline.begin());
+                delete[] heap.data;
+            }
+            m_size = new_size;
+            if (erased_until_end) {
+                return cend();
+            }
+            return ConstIterator{ reinterpret_cast<std::byte const*>(c_str() + start) };
+        }
+
+        void append(Utf8Char const c) {
+            auto const bytes = c.as_string_view();
+            append_unchecked(bytes, bytes.size() == 1);
+        }
+
+        void append(Utf8StringView const view) {
+            append_unchecked(view.view(), view.is_ascii());
+        }
+
+        InlineUtf8String& operator+=(Utf8Char const c) {
+            append(c);
+            return *this;
+        }
+
+        InlineUtf8String& operator+=(Utf8StringView const view) {
+            append(view);
+            return *this;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, InlineUtf8String const& string) {
+            return os << string.view();
+        }
+
+    private:
+        [[nodiscard]] std::size_t byte_offset(ConstIterator const& iterator) const {
+            return static_cast<std::size_t>(reinterpret_cast<char const*>(iterator.m_next_char_start) - c_str());
+        }
+
+        void append_unchecked(std::string_view const data, bool const is_ascii) {
+            auto const new_size = m_size + data.size();
+            if (new_size <= inline_capacity) {
+                std::ranges::copy(data, m_inline.begin() + static_cast<std::ptrdiff_t>(m_size));
+                m_inline[new_size] = '\0';
+            } else if (is_inline()) {
+                auto const capacity = std::max(new_size, 2 * inline_capacity);
+                auto const buffer = new char[capacity + 1];
+                // `data` may point into `m_inline`, so it is copied before `m_heap` becomes the active member
+                std::copy(m_inline.data(), m_inline.data() + m_size, buffer);
+                std::ranges::copy(data, buffer + m_size);
+                buffer[new_size] = '\0';
+                m_heap = HeapBuffer{ buffer, capacity };
+            } else if (new_size > m_heap.capacity) {
+                auto const capacity = std::max(new_size, 2 * m_heap.capacity);
+                auto const buffer = new char[capacity + 1];
+                // `data` may point into the old buffer, so it is released last
+                std::copy(m_heap.data, m_heap.data + m_size, buffer);
+                std::ranges::copy(data, buffer + m_size);
+                buffer[new_size] = '\0';
+                delete[] m_heap.data;
+                m_heap = HeapBuffer{ buffer, capacity };
+            } else {
+                std::ranges::copy(data, m_heap.data + m_size);
+                m_heap.data[new_size] = '\0';
+            }
+            m_size = new_size;
+            m_is_ascii = m_is_ascii and is_ascii;
+        }
+
+        // Leaves `other` empty.
+        void take_over(InlineUtf8String& other) noexcept {
+            if (other.is_inline()) {
+                m_inline = other.m_inline;
+            } else {
+                m_heap = other.m_heap;
+                other.m_inline = {};
+            }
+            m_size = other.m_size;
+            m_is_ascii = other.m_is_ascii;
+            other.m_size = 0;
+            other.m_is_ascii = true;
+        }
+    };
+} // namespace c2k
+
+template<std::size_t inline_capacity>
+struct std::hash<c2k::InlineUtf8String<inline_capacity>> {
+    [[nodiscard]] std::size_t operator()(c2k::InlineUtf8String<inline_capacity> const& string) const noexcept {
+        return std::hash<std::string_view>{}(string.view());
+    }
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "string_view.hpp"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace c2k {
+    class Utf8Interner;
+
+    namespace detail {
+        // Header of a string in the arena of a Utf8Interner. The (null-terminated) data follows directly.
+        struct InternedString final {
+            std::size_t hash;
+            std::size_t num_bytes;
+            bool is_ascii;
+
+            [[nodiscard]] char const* data() const {
+                return reinterpret_cast<char const*>(this + 1);
+            }
+
+            [[nodiscard]] std::string_view view() const {
+                return std::string_view{ data(), num_bytes };
+            }
+        };
+    } // namespace detail
+
+    // Handle to a string that has been interned by a Utf8Interner. Since every string is only stored once
+    // per interner, comparing atoms only compares pointers. Atoms stay valid as long as their interner exists.
+    // A default-constructed atom represents the empty string (which is never stored by an interner).
+    class Utf8Atom final {
+        friend class Utf8Interner;
+
+    private:
+        static inline auto const empty_string = detail::InternedString{ std::hash<std::string_view>{}(""), 0, true };
+
+        detail::InternedString const* m_string{ &empty_string };
+
+        explicit Utf8Atom(detail::InternedString const* const string) : m_string{ string } { }
+
+    public:
+        Utf8Atom() = default;
+
+        // The hash is computed once when the string is interned and equals std::hash<Utf8StringView>.
+        [[nodiscard]] std::size_t hash() const {
+            return m_string->hash;
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_string->num_bytes == 0;
+        }
+
+        [[nodiscard]] std::string_view view() const {
+            return m_string->view();
+        }
+
+        [[nodiscard]] Utf8StringView as_view() const;
+
+        operator Utf8StringView() const { // NOLINT (implicit conversion operator)
+            return as_view();
+        }
+
+        [[nodiscard]] bool operator==(Utf8Atom const& other) const = default;
+    };
+
+    // Thread-safe pool of interned strings. Looking up a string that has already been interned is lock-free:
+    // the hash table is only ever appended to, and when it grows, the previous table is kept alive for readers
+    // that are still using it. Inserting new strings is serialized by a mutex. The strings are stored in
+    // contiguous chunks of memory that are only freed together with the interner.
+    class Utf8Interner final {
+    private:
+        struct Table;
+
+        std::atomic<Table const*> m_table{ nullptr };
+        mutable std::mutex m_mutex;
+        std::vector<std::unique_ptr<Table>> m_tables;
+        std::vector<std::unique_ptr<std::byte[]>> m_chunks;
+        std::size_t m_chunk_used{ 0 };
+        std::size_t m_chunk_capacity{ 0 };
+        std::size_t m_size{ 0 };
+
+    public:
+        Utf8Interner();
+        Utf8Interner(Utf8Interner const& other) = delete;
+        Utf8Interner(Utf8Interner&& other) = delete;
+        Utf8Interner& operator=(Utf8Interner const& other) = delete;
+        Utf8Interner& operator=(Utf8Interner&& other) = delete;
+        ~Utf8Interner();
+
+        [[nodiscard]] Utf8Atom intern(Utf8StringView string);
+
+        // Never blocks and never allocates.
+        [[nodiscard]] std::optional<Utf8Atom> find(Utf8StringView string) const;
+
+        [[nodiscard]] std::size_t size() const;
+
+    private:
+        [[nodiscard]] detail::InternedString const* store(std::string_view string, std::size_t hash, bool is_ascii);
+        void grow();
+    };
+} // namespace c2k
+
+template<>
+struct std::hash<c2k::Utf8Atom> {
+    [[nodiscard]] std::size_t operator()(c2k::Utf8Atom const& atom) const noexcept {
+        return atom.hash();
+    }
+};
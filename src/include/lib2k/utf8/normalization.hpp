@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace c2k {
+    class Utf8String;
+    class Utf8StringView;
+
+    enum class NormalizationForm {
+        Nfc,
+        Nfd,
+        Nfkc,
+        Nfkd,
+    };
+
+    // The result of normalizing a string. If the string already was normalized, this only refers to it (so the
+    // string must outlive this object). Otherwise, it owns the normalized string. Since it is not known upfront
+    // which of both applies, the owning string types cannot be normalized as temporaries, and view() must not
+    // outlive this object either way.
+    class Utf8Normalized final {
+        friend class Utf8StringView;
+
+    private:
+        std::string_view m_unchanged;
+        std::string m_normalized;
+        bool m_was_normalized{ true };
+
+        explicit Utf8Normalized(std::string_view unchanged);
+        explicit Utf8Normalized(std::string normalized);
+
+    public:
+        // Returns whether the input was already normalized (and no allocation took place).
+        [[nodiscard]] bool was_normalized() const {
+            return m_was_normalized;
+        }
+
+        [[nodiscard]] Utf8StringView view() const;
+        [[nodiscard]] Utf8String to_string() const&;
+        [[nodiscard]] Utf8String to_string() &&;
+    };
+} // namespace c2k
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "../concepts.hpp"
+#include "../string_utils.hpp"
+#include "char.hpp"
+#include "errors.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+#include <vector>
+
+namespace c2k::pmr {
+    // UTF-8 string that obtains its memory from a std::pmr::memory_resource. This allows for allocating all
+    // strings of, e.g., a request from a std::pmr::monotonic_buffer_resource and freeing them at once.
+    // As with std::pmr::string, the memory resource is not propagated by copy construction or assignment.
+    //
+    // The operations that create new strings allocate from `resource` or, if it is nullptr, from the memory
+    // resource of the string they are called on.
+    class Utf8String final {
+    private:
+        std::pmr::string m_data;
+        // see c2k::Utf8String::m_is_ascii
+        bool m_is_ascii{ true };
+
+    public:
+        using allocator_type = std::pmr::polymorphic_allocator<char>;
+        using ConstIterator = detail::Utf8ConstIterator;
+        using ReverseIterator = detail::Utf8ConstReverseIterator;
+
+        Utf8String() = default;
+        explicit Utf8String(allocator_type allocator);
+        Utf8String(Utf8StringView view, allocator_type allocator = {}); // NOLINT (implicit converting constructor)
+        Utf8String(char const* chars, allocator_type allocator = {});   // NOLINT (implicit converting constructor)
+        Utf8String(Utf8String const& other, allocator_type allocator);
+        Utf8String(Utf8String&& other, allocator_type allocator);
+        Utf8String(Utf8String const& other) = default;
+        Utf8String(Utf8String&& other) noexcept = default;
+        Utf8String& operator=(Utf8String const& other) = default;
+        Utf8String& operator=(Utf8String&& other) = default;
+        ~Utf8String() = default;
+
+        // clang-format off
+        [[nodiscard]] static tl::expected<Utf8String, Utf8Error> from_chars(
+            std::string_view chars,
+            allocator_type allocator = {}
+        ); // clang-format on
+
+        [[nodiscard]] allocator_type get_allocator() const {
+            return m_data.get_allocator();
+        }
+
+        [[nodiscard]] bool is_ascii() const {
+            return as_view().is_ascii();
+        }
+
+        [[nodiscard]] char const* c_str() const {
+            return m_data.c_str();
+        }
+
+        [[nodiscard]] std::string_view view() const {
+            return std::string_view{ m_data };
+        }
+
+        [[nodiscard]] Utf8StringView as_view() const;
+
+        operator Utf8StringView() const { // NOLINT (implicit conversion operator)
+            return as_view();
+        }
+
+        [[nodiscard]] c2k::Utf8String to_string() const {
+            return c2k::Utf8String{ as_view() };
+        }
+
+        [[nodiscard]] std::size_t num_bytes() const {
+            return m_data.size();
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_data.empty();
+        }
+
+        [[nodiscard]] bool is_not_empty() const {
+            return not is_empty();
+        }
+
+        [[nodiscard]] std::size_t calculate_char_count() const {
+            return as_view().calculate_char_count();
+        }
+
+        [[nodiscard]] std::size_t calculate_char_width() const {
+            return as_view().calculate_char_width();
+        }
+
+        [[nodiscard]] Utf8Char front() const {
+            return as_view().front();
+        }
+
+        [[nodiscard]] Utf8Char back() const {
+            return as_view().back();
+        }
+
+        [[nodiscard]] ConstIterator begin() const {
+            return as_view().begin();
+        }
+
+        [[nodiscard]] ConstIterator cbegin() const {
+            return begin();
+        }
+
+        [[nodiscard]] ConstIterator end() const {
+            return as_view().end();
+        }
+
+        [[nodiscard]] ConstIterator cend() const {
+            return end();
+        }
+
+        [[nodiscard]] ReverseIterator rbegin() const {
+            return as_view().rbegin();
+        }
+
+        [[nodiscard]] ReverseIterator crbegin() const {
+            return rbegin();
+        }
+
+        [[nodiscard]] ReverseIterator rend() const {
+            return as_view().rend();
+        }
+
+        [[nodiscard]] ReverseIterator crend() const {
+            return rend();
+        }
+
+        [[nodiscard]] Utf8CodepointRange codepoints() const {
+            return as_view().codepoints();
+        }
+
+        [[nodiscard]] Utf8CharSpanRange char_spans() const {
+            return as_view().char_spans();
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8Char const needle) const {
+            return as_view().find(needle);
+        }
+
+        [[nodiscard]] ConstIterator find(Utf8StringView const needle) const {
+            return as_view().find(needle);
+        }
+
+        // clang-format off
+        [[nodiscard]] Utf8String substring(
+            std::size_t start,
+            std::size_t num_chars,
+            std::pmr::memory_resource* resource = nullptr
+        ) const; // clang-format on
+        [[nodiscard]] Utf8String substring(std::size_t start, std::pmr::memory_resource* resource = nullptr) const;
+
+        [[nodiscard]] Utf8String to_uppercase(std::pmr::memory_resource* resource = nullptr) const;
+        [[nodiscard]] Utf8String to_lowercase(std::pmr::memory_resource* resource = nullptr) const;
+
+        // clang-format off
+        [[nodiscard]] Utf8String replace(
+            Utf8StringView to_replace,
+            Utf8StringView replacement,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+        [[nodiscard]] Utf8String replace(
+            Utf8StringView to_replace,
+            Utf8StringView replacement,
+            MaxReplacementCount max_num_replacements,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+        // The result and all of its elements use the same memory resource.
+        [[nodiscard]] std::pmr::vector<Utf8String> split(
+            Utf8StringView delimiter,
+            std::pmr::memory_resource* resource = nullptr
+        ) const;
+
+        [[nodiscard]] Utf8String join(
+            Iterable<Utf8StringView> auto const& iterable,
+            std::pmr::memory_resource* const resource = nullptr
+        ) const { // clang-format on
+            auto result = Utf8String{ allocator_type{ resource_or_own(resource) } };
+            auto is_first = true;
+            for (auto const& part : iterable) {
+                if (not is_first) {
+                    result += *this;
+                }
+                result += Utf8StringView{ part };
+                is_first = false;
+            }
+            return result;
+        }
+
+        [[nodiscard]] bool operator==(Utf8StringView const other) const {
+            return view() == other.view();
+        }
+
+        [[nodiscard]] bool operator==(Utf8String const& other) const {
+            return view() == other.view();
+        }
+
+        [[nodiscard]] bool operator==(c2k::Utf8String const& other) const {
+            return view() == other.view();
+        }
+
+        [[nodiscard]] bool operator==(char const* const other) const {
+            return *this == Utf8StringView{ other };
+        }
+
+        void reserve(std::size_t const num_bytes) {
+            m_data.reserve(num_bytes);
+        }
+
+        void clear() {
+            m_data.clear();
+            m_is_ascii = true;
+        }
+
+        void append(Utf8Char c);
+        void append(Utf8StringView view);
+
+        Utf8String& operator+=(Utf8Char const c) {
+            append(c);
+            return *this;
+        }
+
+        Utf8String& operator+=(Utf8StringView const view) {
+            append(view);
+            return *this;
+        }
+
+        friend std::ostream& operator<<(std::ostream& os, Utf8String const& string) {
+            return os << string.m_data;
+        }
+
+    private:
+        [[nodiscard]] std::pmr::memory_resource* resource_or_own(std::pmr::memory_resource* resource) const {
+            return resource == nullptr ? m_data.get_allocator().resource() : resource;
+        }
+    };
+} // namespace c2k::pmr
+
+template<>
+struct std::hash<c2k::pmr::Utf8String> {
+    [[nodiscard]] std::size_t operator()(c2k::pmr::Utf8String const& string) const noexcept {
+        return std::hash<std::string_view>{}(string.view());
+    }
+};
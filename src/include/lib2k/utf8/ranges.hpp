@@ -0,0 +1,217 @@
+#pragma once
+
+#include "../string_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+
+namespace c2k {
+    class Utf8String;
+    class Utf8StringView;
+
+    namespace detail {
+        // Continuation bytes and invalid lead bytes are treated as sequences of length 1 so that
+        // iteration always makes progress.
+        inline constexpr auto utf8_sequence_lengths = [] {
+            auto result = std::array<std::uint8_t, 256>{};
+            for (auto i = std::size_t{ 0 }; i < result.size(); ++i) {
+                if (i >= 0b1111'0000 and i < 0b1111'1000) {
+                    result[i] = 4;
+                } else if (i >= 0b1110'0000 and i < 0b1111'0000) {
+                    result[i] = 3;
+                } else if (i >= 0b1100'0000 and i < 0b1110'0000) {
+                    result[i] = 2;
+                } else {
+                    result[i] = 1;
+                }
+            }
+            return result;
+        }();
+
+        inline constexpr auto utf8_lead_byte_masks = std::array<std::uint8_t, 5>{ 0, 0x7F, 0x1F, 0x0F, 0x07 };
+
+        // clang-format off
+        [[nodiscard]] constexpr std::size_t utf8_sequence_length(
+            std::byte const* const position,
+            std::byte const* const end
+        ) { // clang-format on
+            auto const length = utf8_sequence_lengths[static_cast<std::uint8_t>(*position)];
+            return std::min(static_cast<std::size_t>(length), static_cast<std::size_t>(end - position));
+        }
+
+        [[nodiscard]] constexpr char32_t decode_utf8(std::byte const* const position, std::size_t const length) {
+            auto result = static_cast<char32_t>(static_cast<std::uint8_t>(*position) & utf8_lead_byte_masks[length]);
+            for (auto i = std::size_t{ 1 }; i < length; ++i) {
+                result = (result << 6) | static_cast<char32_t>(static_cast<std::uint8_t>(position[i]) & 0b0011'1111);
+            }
+            return result;
+        }
+
+        // The code point must be valid. Returns the number of bytes written to `destination`.
+        [[nodiscard]] constexpr std::size_t encode_utf8(char32_t const codepoint, std::byte* const destination) {
+            if (codepoint < 0x80) {
+                destination[0] = static_cast<std::byte>(codepoint);
+                return 1;
+            }
+            if (codepoint < 0x800) {
+                destination[0] = static_cast<std::byte>(0b1100'0000 | (codepoint >> 6));
+                destination[1] = static_cast<std::byte>(0b1000'0000 | (codepoint & 0b0011'1111));
+                return 2;
+            }
+            if (codepoint < 0x1'0000) {
+                destination[0] = static_cast<std::byte>(0b1110'0000 | (codepoint >> 12));
+                destination[1] = static_cast<std::byte>(0b1000'0000 | ((codepoint >> 6) & 0b0011'1111));
+                destination[2] = static_cast<std::byte>(0b1000'0000 | (codepoint & 0b0011'1111));
+                return 3;
+            }
+            destination[0] = static_cast<std::byte>(0b1111'0000 | (codepoint >> 18));
+            destination[1] = static_cast<std::byte>(0b1000'0000 | ((codepoint >> 12) & 0b0011'1111));
+            destination[2] = static_cast<std::byte>(0b1000'0000 | ((codepoint >> 6) & 0b0011'1111));
+            destination[3] = static_cast<std::byte>(0b1000'0000 | (codepoint & 0b0011'1111));
+            return 4;
+        }
+
+        class Utf8CodepointIterator final {
+        private:
+            std::byte const* m_position{ nullptr };
+            std::byte const* m_end{ nullptr };
+
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = char32_t;
+
+            constexpr Utf8CodepointIterator() = default;
+
+            constexpr Utf8CodepointIterator(std::byte const* const position, std::byte const* const end)
+                : m_position{ position },
+                  m_end{ end } { }
+
+            [[nodiscard]] constexpr char32_t operator*() const {
+                return decode_utf8(m_position, utf8_sequence_length(m_position, m_end));
+            }
+
+            constexpr Utf8CodepointIterator& operator++() {
+                m_position += utf8_sequence_length(m_position, m_end);
+                return *this;
+            }
+
+            [[nodiscard]] constexpr Utf8CodepointIterator operator++(int) {
+                auto const result = *this;
+                ++(*this);
+                return result;
+            }
+
+            [[nodiscard]] constexpr bool operator==(Utf8CodepointIterator const& other) const {
+                return m_position == other.m_position;
+            }
+        };
+
+        class Utf8CharSpanIterator final {
+        private:
+            std::byte const* m_position{ nullptr };
+            std::byte const* m_end{ nullptr };
+
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = std::span<std::byte const>;
+
+            constexpr Utf8CharSpanIterator() = default;
+
+            constexpr Utf8CharSpanIterator(std::byte const* const position, std::byte const* const end)
+                : m_position{ position },
+                  m_end{ end } { }
+
+            [[nodiscard]] constexpr std::span<std::byte const> operator*() const {
+                return std::span{ m_position, utf8_sequence_length(m_position, m_end) };
+            }
+
+            constexpr Utf8CharSpanIterator& operator++() {
+                m_position += utf8_sequence_length(m_position, m_end);
+                return *this;
+            }
+
+            [[nodiscard]] constexpr Utf8CharSpanIterator operator++(int) {
+                auto const result = *this;
+                ++(*this);
+                return result;
+            }
+
+            [[nodiscard]] constexpr bool operator==(Utf8CharSpanIterator const& other) const {
+                return m_position == other.m_position;
+            }
+        };
+
+        static_assert(std::forward_iterator<Utf8CodepointIterator>);
+        static_assert(std::forward_iterator<Utf8CharSpanIterator>);
+
+        // Ranges over the chars of a validated UTF-8 string that do not construct a Utf8Char for
+        // each step (as opposed to Utf8ConstIterator). The decoder never reads past the end of the string.
+        template<typename Iterator>
+        class Utf8Range final : public std::ranges::view_interface<Utf8Range<Iterator>> {
+            friend class ::c2k::Utf8String;
+            friend class ::c2k::Utf8StringView;
+
+        private:
+            std::byte const* m_begin{ nullptr };
+            std::byte const* m_end{ nullptr };
+
+            explicit Utf8Range(std::string_view const data)
+                : m_begin{ reinterpret_cast<std::byte const*>(data.data()) },
+                  m_end{ reinterpret_cast<std::byte const*>(data.data() + data.size()) } { }
+
+        public:
+            constexpr Utf8Range() = default;
+
+            [[nodiscard]] constexpr Iterator begin() const {
+                return Iterator{ m_begin, m_end };
+            }
+
+            [[nodiscard]] constexpr Iterator end() const {
+                return Iterator{ m_end, m_end };
+            }
+        };
+
+        // The search uses the SIMD substring kernel.
+        struct Utf8SplitTraits final {
+            using Part = Utf8StringView;
+
+            [[nodiscard]] static Utf8StringView make_part(std::string_view part);
+            // clang-format off
+            [[nodiscard]] static std::size_t find(
+                std::string_view haystack,
+                std::string_view needle,
+                std::size_t start
+            ); // clang-format on
+        };
+
+        // Any of the (possibly multi-byte) chars of `chars` delimits tokens. The candidates are found by searching
+        // for their lead bytes with SIMD instructions.
+        struct Utf8CharDelimiters final {
+            using Token = Utf8StringView;
+
+            ByteSet lead_bytes;
+            std::string_view chars;
+
+            [[nodiscard]] static Utf8StringView make_token(std::string_view token);
+            [[nodiscard]] std::size_t match_length(std::string_view s, std::size_t position) const;
+            [[nodiscard]] std::size_t find(std::string_view s, std::size_t start) const;
+        };
+    } // namespace detail
+
+    using Utf8CodepointRange = detail::Utf8Range<detail::Utf8CodepointIterator>;
+    using Utf8CharSpanRange = detail::Utf8Range<detail::Utf8CharSpanIterator>;
+    using Utf8SplitView = detail::BasicSplitView<detail::Utf8SplitTraits>;
+    using Utf8TokenView = detail::BasicTokenView<detail::Utf8CharDelimiters>;
+} // namespace c2k
+
+template<typename Iterator>
+inline constexpr bool std::ranges::enable_borrowed_range<c2k::detail::Utf8Range<Iterator>> = true;
+
+static_assert(std::ranges::view<c2k::Utf8CodepointRange>);
+static_assert(std::ranges::forward_range<c2k::Utf8CodepointRange>);
+static_assert(std::ranges::borrowed_range<c2k::Utf8CharSpanRange>);
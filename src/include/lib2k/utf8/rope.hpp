@@ -0,0 +1,150 @@
+#pragma once
+
+#include "char.hpp"
+#include "string.hpp"
+#include "string_view.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace c2k {
+    class Utf8Rope;
+
+    namespace detail {
+        // Node of the treap that backs a Utf8Rope. Every node holds a chunk of the text: the text of a subtree
+        // is the text of the left subtree, followed by the chunk, followed by the text of the right subtree.
+        struct RopeNode final {
+            std::string chunk;
+            std::size_t chunk_num_chars{ 0 };
+            std::uint32_t priority{ 0 };
+            // aggregated over the whole subtree
+            std::size_t num_bytes{ 0 };
+            std::size_t num_chars{ 0 };
+            std::unique_ptr<RopeNode> left;
+            std::unique_ptr<RopeNode> right;
+        };
+
+        class Utf8RopeIterator final {
+            friend class ::c2k::Utf8Rope;
+
+        private:
+            RopeNode const* m_root{ nullptr };
+            RopeNode const* m_node{ nullptr };
+            std::size_t m_node_start{ 0 };
+            std::size_t m_offset{ 0 };
+
+            Utf8RopeIterator(RopeNode const* root, std::size_t byte_offset);
+
+        public:
+            using difference_type = std::ptrdiff_t;
+            using value_type = Utf8Char;
+
+            Utf8RopeIterator() = default;
+
+            [[nodiscard]] Utf8Char operator*() const;
+
+            Utf8RopeIterator& operator++();
+
+            [[nodiscard]] Utf8RopeIterator operator++(int) {
+                auto const result = *this;
+                ++(*this);
+                return result;
+            }
+
+            // The position in bytes from the start of the rope.
+            [[nodiscard]] std::size_t byte_offset() const {
+                return m_node_start + m_offset;
+            }
+
+            [[nodiscard]] bool operator==(Utf8RopeIterator const& other) const {
+                return m_node == other.m_node and m_offset == other.m_offset;
+            }
+        };
+
+        static_assert(std::forward_iterator<Utf8RopeIterator>);
+    } // namespace detail
+
+    // Text buffer for large documents that are edited in the middle. The text is split into chunks of at most
+    // max_chunk_size bytes that are stored in a balanced tree (a treap), so that inserting, erasing and
+    // char-indexed lookups take O(log n) time (plus the size of a chunk) instead of moving the whole text.
+    class Utf8Rope final {
+    private:
+        std::unique_ptr<detail::RopeNode> m_root;
+        std::uint32_t m_random_state{ 0x9E37'79B9 };
+
+    public:
+        using ConstIterator = detail::Utf8RopeIterator;
+
+        static constexpr auto max_chunk_size = std::size_t{ 1024 };
+
+        Utf8Rope() = default;
+        explicit Utf8Rope(Utf8StringView text);
+        Utf8Rope(Utf8Rope const& other);
+        Utf8Rope(Utf8Rope&& other) noexcept = default;
+        Utf8Rope& operator=(Utf8Rope const& other);
+        Utf8Rope& operator=(Utf8Rope&& other) noexcept = default;
+        ~Utf8Rope();
+
+        [[nodiscard]] bool is_empty() const {
+            return m_root == nullptr;
+        }
+
+        [[nodiscard]] std::size_t num_bytes() const {
+            return m_root == nullptr ? 0 : m_root->num_bytes;
+        }
+
+        // O(1), since the number of chars is kept up to date by all modifications.
+        [[nodiscard]] std::size_t char_count() const {
+            return m_root == nullptr ? 0 : m_root->num_chars;
+        }
+
+        // Throws std::out_of_range if `char_index` is greater than char_count().
+        void insert(std::size_t char_index, Utf8StringView text);
+        void append(Utf8StringView text);
+        // Erases up to `num_chars` chars (less if the end of the rope is reached).
+        void erase(std::size_t char_index, std::size_t num_chars);
+        void clear();
+
+        // Throws std::out_of_range if `char_index` is not less than char_count().
+        [[nodiscard]] Utf8Char char_at(std::size_t char_index) const;
+
+        [[nodiscard]] ConstIterator begin() const;
+        [[nodiscard]] ConstIterator end() const;
+
+        [[nodiscard]] ConstIterator cbegin() const {
+            return begin();
+        }
+
+        [[nodiscard]] ConstIterator cend() const {
+            return end();
+        }
+
+        [[nodiscard]] ConstIterator iterator_at(std::size_t char_index) const;
+
+        // Returns end() if `needle` is not found. Matches may span multiple chunks.
+        [[nodiscard]] ConstIterator find(Utf8StringView needle) const;
+        [[nodiscard]] ConstIterator find(Utf8StringView needle, std::size_t start_char_index) const;
+
+        // Views of the chunks (in order) that remain valid until the rope is modified.
+        [[nodiscard]] std::vector<Utf8StringView> chunks() const;
+
+        [[nodiscard]] Utf8String to_string() const;
+
+        [[nodiscard]] bool operator==(Utf8StringView other) const;
+
+    private:
+        [[nodiscard]] std::uint32_t next_priority();
+        [[nodiscard]] std::unique_ptr<detail::RopeNode> make_node(std::string chunk);
+        [[nodiscard]] std::unique_ptr<detail::RopeNode> build(Utf8StringView text);
+        // clang-format off
+        [[nodiscard]] std::pair<std::unique_ptr<detail::RopeNode>, std::unique_ptr<detail::RopeNode>> split(
+            std::unique_ptr<detail::RopeNode> node,
+            std::size_t char_index
+        ); // clang-format on
+        [[nodiscard]] std::size_t byte_offset_of(std::size_t char_index) const;
+    };
+} // namespace c2k
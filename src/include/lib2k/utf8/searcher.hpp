@@ -0,0 +1,35 @@
+#pragma once
+
+#include "string_view.hpp"
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace c2k {
+    // Searches for a needle that is analyzed only once, so that repeated searches for the same needle (within
+    // many haystacks, or by split() and replace()) do not have to start from scratch. Short needles are found
+    // by comparing the first and the last byte of the needle at many positions at once (using SIMD
+    // instructions). Long needles use the Boyer-Moore-Horspool algorithm, which skips ahead by up to the
+    // length of the needle.
+    class Utf8Searcher final {
+    private:
+        std::string m_needle;
+        // Boyer-Moore-Horspool: how far to advance depending on the last byte of the current window (only
+        // used for long needles)
+        std::vector<std::size_t> m_shifts;
+
+    public:
+        static constexpr auto min_horspool_needle_size = std::size_t{ 64 };
+
+        explicit Utf8Searcher(Utf8StringView needle);
+
+        [[nodiscard]] Utf8StringView needle() const {
+            return Utf8StringView::from_string_view_unchecked(m_needle);
+        }
+
+        // Returns the byte offset of the first occurrence of the needle that starts at or after `start_offset`
+        // (or std::string_view::npos if there is none). An empty needle is found at `start_offset`.
+        [[nodiscard]] std::size_t find_in(std::string_view haystack, std::size_t start_offset = 0) const;
+    };
+} // namespace c2k
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "errors.hpp"
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <tl/expected.hpp>
+
+namespace c2k {
+    // Validates UTF-8 input that arrives in chunks of arbitrary size. A multibyte char that is split across
+    // chunks is kept until the next call to feed(). Once an error has been found, every further call fails.
+    class Utf8StreamValidator final {
+    private:
+        std::array<unsigned char, 4> m_pending{};
+        std::size_t m_num_pending{ 0 };
+        std::size_t m_num_complete_bytes{ 0 };
+        bool m_has_error{ false };
+
+    public:
+        // Returns the number of bytes at the start of `chunk` that complete a char. The remaining bytes (at
+        // most 3) begin a char that has to be completed by the next chunk.
+        [[nodiscard]] tl::expected<std::size_t, Utf8Error> feed(std::string_view chunk);
+
+        // Fails if the stream is invalid or ends in the middle of a char.
+        [[nodiscard]] tl::expected<void, Utf8Error> finish() const;
+
+        // The total number of bytes (across all chunks) that form complete chars.
+        [[nodiscard]] std::size_t num_complete_bytes() const {
+            return m_num_complete_bytes;
+        }
+
+        [[nodiscard]] std::size_t num_pending_bytes() const {
+            return m_num_pending;
+        }
+
+        void reset() {
+            *this = Utf8StreamValidator{};
+        }
+    };
+} // namespace c2k
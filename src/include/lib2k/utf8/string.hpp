@@ -5,15 +5,33 @@
 #include "char.hpp"
 #include "const_iterator.hpp"
 #include "const_reverse_iterator.hpp"
+#include "graphemes.hpp"
+#include "normalization.hpp"
+#include "ranges.hpp"
+#include "string_builder.hpp"
+#include "transcoding.hpp"
+#include <algorithm>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <tl/expected.hpp>
+#include <vector>
 
 namespace c2k {
     namespace detail {
         class Utf8ConstReverseIterator;
-    }
+        class Utf8CharIndex;
+    } // namespace detail
     class Utf8String;
+    class Utf8Searcher;
+    struct Utf8RepairResult;
+    template<std::size_t inline_capacity>
+    class InlineUtf8String;
+
+    enum class Utf8ErrorReporting {
+        FirstError,
+        AllErrors,
+    };
 
     namespace Utf8Literals {
         [[nodiscard]] Utf8String operator""_utf8(char const* str, std::size_t length);
@@ -21,15 +39,30 @@ namespace c2k {
 
     class Utf8String final {
         friend class Utf8StringView;
+        friend class Utf8StringBuilder;
+        friend class Utf8Normalized;
+        template<std::size_t inline_capacity>
+        friend class InlineUtf8String;
+        friend tl::expected<Utf8String, Utf8Error> transcode_from_utf16(std::u16string_view source);
+        friend tl::expected<Utf8String, Utf8Error> transcode_from_utf32(std::u32string_view source);
         friend Utf8String Utf8Literals::operator""_utf8(char const* str, std::size_t length);
 
     private:
         std::string m_data;
+        // Strings that are known to only contain ASCII characters allow for char-indexed operations in O(1).
+        // The flag is conservative: it may be false for strings that happen to contain only ASCII characters.
+        bool m_is_ascii{ true };
+        // Optional lookup table for char-indexed access (see enable_char_index()). It is built lazily and
+        // replaced on every mutation. Copies of a string share the table until either of them is modified.
+        std::shared_ptr<detail::Utf8CharIndex> m_char_index;
 
     public:
         using ConstIterator = detail::Utf8ConstIterator;
         using ReverseIterator = detail::Utf8ConstReverseIterator;
 
+        // The char index stores the byte offset of every `char_index_stride`-th character.
+        static constexpr auto char_index_stride = std::size_t{ 64 };
+
         Utf8String() = default;
         Utf8String(std::string string);  // NOLINT (implicit converting constructor)
         Utf8String(char const* string);  // NOLINT (implicit converting constructor)
@@ -39,8 +72,26 @@ namespace c2k {
 
         [[nodiscard]] static Utf8String from_string_unchecked(std::string data);
         [[nodiscard]] static tl::expected<Utf8String, Utf8Error> from_chars(std::string chars);
+        // Replaces every maximal ill-formed subsequence with U+FFFD (see section 3.9 of the Unicode standard).
+        // Valid input is taken over without copying. Otherwise, the replacements are done in place and only
+        // reallocate if the repaired string exceeds the capacity of `chars`.
+        [[nodiscard]] static Utf8String from_chars_lossy(std::string chars);
+        [[nodiscard]] static Utf8RepairResult from_chars_lossy(std::string chars, Utf8ErrorReporting reporting);
         [[nodiscard]] static bool is_valid_utf8(std::string_view string);
 
+        [[nodiscard]] bool is_ascii() const;
+
+        // Char-indexed operations (substring(), find() with a start position, iterator_at(), char_index_of(),
+        // ...) take O(n) time for non-ASCII strings. After enabling the char index, they only take
+        // O(char_index_stride) time (plus O(n) once to build the index on first use).
+        void enable_char_index();
+        void disable_char_index();
+        [[nodiscard]] bool has_char_index() const;
+
+        [[nodiscard]] ConstIterator iterator_at(std::size_t char_index) const;
+        [[nodiscard]] std::size_t char_index_of(ConstIterator const& position) const;
+        [[nodiscard]] std::size_t distance(ConstIterator const& first, ConstIterator const& last) const;
+
         [[nodiscard]] char const* c_str() const {
             return m_data.data();
         }
@@ -53,9 +104,7 @@ namespace c2k {
             return m_data.size();
         }
 
-        [[nodiscard]] std::size_t calculate_char_count() const {
-            return static_cast<std::size_t>(cend() - cbegin());
-        }
+        [[nodiscard]] std::size_t calculate_char_count() const;
 
         [[nodiscard]] std::size_t calculate_char_width() const;
 
@@ -110,6 +159,18 @@ namespace c2k {
             return rend();
         }
 
+        [[nodiscard]] Utf8CodepointRange codepoints() const {
+            return Utf8CodepointRange{ m_data };
+        }
+
+        [[nodiscard]] Utf8CharSpanRange char_spans() const {
+            return Utf8CharSpanRange{ m_data };
+        }
+
+        [[nodiscard]] Utf8GraphemeRange graphemes() const {
+            return Utf8GraphemeRange{ m_data };
+        }
+
         void append(Utf8Char c);
 
         void append(char const* c_string);
@@ -151,6 +212,8 @@ namespace c2k {
 
         void clear() {
             m_data.clear();
+            m_is_ascii = true;
+            invalidate_char_index();
         }
 
         void reserve(std::size_t new_capacity_in_bytes);
@@ -161,6 +224,7 @@ namespace c2k {
         [[nodiscard]] ConstIterator find(Utf8String const& needle) const;
         [[nodiscard]] ConstIterator find(Utf8String const& needle, ConstIterator const& start) const;
         [[nodiscard]] ConstIterator find(Utf8String const& needle, ConstIterator::difference_type start_position) const;
+        [[nodiscard]] ConstIterator find(Utf8Searcher const& searcher) const;
         ConstIterator erase(ConstIterator const& position);
         ConstIterator erase(ConstIterator const& first, ConstIterator const& last);
         void reverse();
@@ -168,28 +232,106 @@ namespace c2k {
         [[nodiscard]] Utf8String to_lowercase() const;
 
         [[nodiscard]] Utf8String transform(Invocable<Utf8Char, Utf8Char> auto&& transformer) const {
-            auto result = Utf8String{};
+            auto builder = Utf8StringBuilder{};
             for (auto const& c : *this) {
-                result += transformer(c);
+                builder += transformer(c);
             }
-            return result;
+            return builder.finish();
         }
 
-        [[nodiscard]] Utf8String join(Iterable<Utf8StringView> auto const& iterable) const {
-            if (std::cbegin(iterable) == std::cend(iterable)) {
-                return {};
+        // The in-place variants only allocate if a mapped char needs more bytes than the original one.
+        void make_uppercase();
+        void make_lowercase();
+
+        [[nodiscard]] bool is_normalized(NormalizationForm form) const;
+        [[nodiscard]] Utf8Normalized normalized(NormalizationForm form) const&;
+        // The result may refer to this string, so it must not be a temporary.
+        Utf8Normalized normalized(NormalizationForm form) const&& = delete;
+        // Does not allocate if the string already is in the requested form.
+        void normalize(NormalizationForm form);
+
+        // If the transformer throws, the chars that have been transformed so far keep their new value and the
+        // others stay unchanged.
+        void transform_in_place(Invocable<Utf8Char, Utf8Char> auto&& transformer) {
+            // only used if a mapped char does not fit into the existing buffer anymore
+            auto new_buffer = std::string{};
+            auto uses_new_buffer = false;
+            // the bytes before `read` have been transformed, the ones from `read` on are unchanged
+            auto read = std::size_t{ 0 };
+            auto write = std::size_t{ 0 };
+            auto is_ascii = true;
+            try {
+                while (read < m_data.size()) {
+                    auto const bytes = reinterpret_cast<std::byte const*>(m_data.data());
+                    auto const num_bytes = detail::utf8_sequence_length(bytes + read, bytes + m_data.size());
+                    auto const mapped =
+                            transformer(Utf8Char::from_bytes_unchecked(std::span{ bytes + read, num_bytes }));
+                    auto const mapped_bytes = mapped.as_string_view();
+                    auto const next_read = read + num_bytes;
+                    if (not uses_new_buffer and write + mapped_bytes.size() > next_read) {
+                        // Every remaining char takes at least one byte and maps to at most four bytes, so this is
+                        // the only reallocation.
+                        new_buffer.reserve(write + mapped_bytes.size() + 4 * (m_data.size() - next_read));
+                        new_buffer.append(m_data, 0, write);
+                        uses_new_buffer = true;
+                    }
+                    if (uses_new_buffer) {
+                        new_buffer.append(mapped_bytes);
+                    } else {
+                        std::copy(mapped_bytes.cbegin(), mapped_bytes.cend(), m_data.data() + write);
+                        write += mapped_bytes.size();
+                    }
+                    is_ascii = is_ascii and mapped_bytes.size() == 1;
+                    read = next_read;
+                }
+            } catch (...) {
+                // Join the transformed prefix and the unchanged rest. This cannot allocate: the new buffer has
+                // room for four times the unchanged bytes.
+                if (uses_new_buffer) {
+                    new_buffer.append(m_data, read);
+                    m_data = std::move(new_buffer);
+                } else {
+                    m_data.erase(write, read - write);
+                }
+                m_is_ascii = m_is_ascii and is_ascii;
+                invalidate_char_index();
+                throw;
             }
-            auto it = std::cbegin(iterable);
-            auto result = Utf8String{ *it };
-            ++it;
-            for (; it != std::cend(iterable); ++it) {
-                result += *this;
-                result += *it;
+            if (uses_new_buffer) {
+                m_data = std::move(new_buffer);
+            } else {
+                m_data.resize(write);
             }
-            return result;
+            m_is_ascii = is_ascii;
+            invalidate_char_index();
+        }
+
+        [[nodiscard]] Utf8String join(Iterable<Utf8StringView> auto const& iterable) const {
+            auto builder = Utf8StringBuilder{};
+            auto is_first = true;
+            for (auto const& part : iterable) {
+                if constexpr (std::same_as<std::decay_t<decltype(part)>, char const*>) {
+                    if (part == nullptr) {
+                        throw std::invalid_argument{ "cannot join nullptr c-strings" };
+                    }
+                }
+                if (not is_first) {
+                    builder.append(*this);
+                }
+                builder.append(Utf8StringView{ part });
+                is_first = false;
+            }
+            return builder.finish();
         }
 
         [[nodiscard]] std::vector<Utf8String> split(Utf8StringView delimiter) const;
+        [[nodiscard]] std::vector<Utf8String> split(Utf8Searcher const& delimiter) const;
+
+        // The parts refer to the data of this string.
+        [[nodiscard]] Utf8SplitView split_view(Utf8StringView delimiter) const;
+        void split_into(Utf8StringView delimiter, std::vector<Utf8StringView>& result) const;
+        [[nodiscard]] Utf8TokenView tokenize(Utf8StringView delimiters) const;
+        void tokenize_into(Utf8StringView delimiters, std::vector<TokenSpan>& result) const;
 
         // clang-format off
         [[nodiscard]] Utf8String replace(
@@ -213,11 +355,33 @@ namespace c2k {
             Utf8StringView replacement,
             MaxReplacementCount max_num_replacements
         ) const;
+
+        [[nodiscard]] Utf8String replace(Utf8Searcher const& to_replace, Utf8StringView replacement) const;
+
+        [[nodiscard]] Utf8String replace(
+            Utf8Searcher const& to_replace,
+            Utf8StringView replacement,
+            MaxReplacementCount max_num_replacements
+        ) const;
         // clang-format on
 
         friend std::ostream& operator<<(std::ostream& os, Utf8String const& string) {
             return os << string.m_data;
         }
+
+    private:
+        [[nodiscard]] static Utf8String from_validated_string(std::string data, bool is_ascii);
+        // Stops at end() if fewer than `num_chars` chars follow `iterator`.
+        [[nodiscard]] ConstIterator advanced(ConstIterator const& iterator, std::size_t num_chars) const;
+        [[nodiscard]] std::size_t byte_offset(ConstIterator const& iterator) const;
+        [[nodiscard]] detail::Utf8CharIndex const& char_index() const;
+        void invalidate_char_index();
+    };
+
+    struct Utf8RepairResult final {
+        Utf8String string;
+        // Byte offsets (into the original chars) of the ill-formed subsequences that have been replaced.
+        std::vector<std::size_t> error_offsets;
     };
 } // namespace c2k
 
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "../concepts.hpp"
+#include "char.hpp"
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace c2k {
+    class Utf8String;
+    class Utf8StringView;
+
+    // Arithmetic types that Utf8StringBuilder formats as numbers (as opposed to chars and bools).
+    template<typename T>
+    concept FormattableNumber = (std::integral<T> or std::floating_point<T>)
+                                and not IsOneOf<T, bool, char, char8_t, char16_t, char32_t, wchar_t>;
+
+    // Collects the parts of a UTF-8 string without validating them again. The parts are copied into chunks that
+    // are never moved, so appending never copies what has been written before. The first chunk is stored
+    // within the builder itself. finish() copies everything into a Utf8String with exactly one allocation.
+    class Utf8StringBuilder final {
+    private:
+        struct Chunk final {
+            std::unique_ptr<char[]> data;
+            std::size_t capacity{ 0 };
+            std::size_t size{ 0 };
+        };
+
+        static constexpr auto inline_capacity = std::size_t{ 256 };
+        static constexpr auto max_chunk_growth = std::size_t{ 1024 * 1024 };
+
+        std::array<char, inline_capacity> m_inline{};
+        std::size_t m_inline_size{ 0 };
+        // Chunks that are not in use (anymore) are kept for reuse after clear().
+        std::vector<Chunk> m_chunks;
+        std::size_t m_num_used_chunks{ 0 };
+        std::size_t m_num_bytes{ 0 };
+        bool m_is_ascii{ true };
+
+    public:
+        Utf8StringBuilder() = default;
+
+        [[nodiscard]] std::size_t num_bytes() const {
+            return m_num_bytes;
+        }
+
+        [[nodiscard]] bool is_empty() const {
+            return m_num_bytes == 0;
+        }
+
+        [[nodiscard]] bool is_ascii() const {
+            return m_is_ascii;
+        }
+
+        // Makes sure that the next `num_bytes` bytes can be appended without allocating.
+        void reserve(std::size_t num_bytes);
+
+        // Keeps the allocated chunks.
+        void clear();
+
+        void append(Utf8Char c);
+        void append(Utf8StringView view);
+        void append(Utf8String const& string);
+
+        // Uses the shortest representation that round-trips (see std::to_chars).
+        template<FormattableNumber T>
+        void append(T const value) {
+            static constexpr auto max_length = std::floating_point<T> ? std::size_t{ 128 } : std::size_t{ 48 };
+            auto const space = contiguous_space(max_length);
+            auto const result = std::to_chars(space.data(), space.data() + space.size(), value);
+            commit(static_cast<std::size_t>(result.ptr - space.data()));
+        }
+
+        Utf8StringBuilder& operator+=(Utf8Char const c) {
+            append(c);
+            return *this;
+        }
+
+        Utf8StringBuilder& operator+=(Utf8StringView view);
+
+        Utf8StringBuilder& operator+=(FormattableNumber auto const value) {
+            append(value);
+            return *this;
+        }
+
+        // The builder is left unchanged, so that it can be appended to and finished again.
+        [[nodiscard]] Utf8String finish() const;
+
+        // Writes the collected string into `buffer` and returns a view of the written bytes. Throws
+        // std::invalid_argument if `buffer` is smaller than num_bytes().
+        [[nodiscard]] Utf8StringView finish_into(std::span<char> buffer) const;
+
+    private:
+        void append_bytes(std::string_view bytes);
+        [[nodiscard]] std::span<char> free_space();
+        [[nodiscard]] std::span<char> contiguous_space(std::size_t num_bytes);
+        void commit(std::size_t num_bytes);
+        void start_chunk(std::size_t min_capacity);
+        void copy_to(char* destination) const;
+    };
+} // namespace c2k
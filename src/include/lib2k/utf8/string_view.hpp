@@ -4,12 +4,23 @@
 #include "../string_utils.hpp"
 #include "const_iterator.hpp"
 #include "const_reverse_iterator.hpp"
+#include "graphemes.hpp"
+#include "normalization.hpp"
+#include "ranges.hpp"
 #include "string.hpp"
+#include <compare>
+#include <memory_resource>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace c2k {
     class Utf8String;
+    class Utf8Searcher;
+
+    namespace pmr {
+        class Utf8String;
+    }
 
     namespace detail {
         class Utf8ConstIterator;
@@ -17,9 +28,16 @@ namespace c2k {
 
     class Utf8StringView final {
         friend class Utf8String;
+        friend class Utf8StringBuilder;
+        friend class pmr::Utf8String;
+        friend class Utf8Atom;
+        template<std::size_t inline_capacity>
+        friend class InlineUtf8String;
 
     private:
         std::string_view m_view;
+        // see Utf8String::m_is_ascii
+        bool m_is_ascii{ true };
 
     public:
         using ConstIterator = detail::Utf8ConstIterator;
@@ -34,6 +52,8 @@ namespace c2k {
 
         [[nodiscard]] static Utf8StringView from_string_view_unchecked(std::string_view view);
 
+        [[nodiscard]] bool is_ascii() const;
+
         [[nodiscard]] constexpr bool is_empty() const {
             return m_view.empty();
         }
@@ -50,12 +70,14 @@ namespace c2k {
             return m_view.length();
         }
 
-        [[nodiscard]] std::size_t calculate_char_count() const {
-            return static_cast<std::size_t>(cend() - cbegin());
-        }
+        [[nodiscard]] std::size_t calculate_char_count() const;
 
         [[nodiscard]] std::size_t calculate_char_width() const;
 
+        [[nodiscard]] bool is_normalized(NormalizationForm form) const;
+        // Only allocates if the view is not in the requested form already.
+        [[nodiscard]] Utf8Normalized normalized(NormalizationForm form) const;
+
         [[nodiscard]] Utf8StringView substring(ConstIterator begin, ConstIterator end) const;
         [[nodiscard]] Utf8StringView substring(ConstIterator begin) const;
         [[nodiscard]] Utf8StringView substring(ConstIterator begin, std::size_t num_chars) const;
@@ -66,6 +88,11 @@ namespace c2k {
             return m_view == other.m_view;
         }
 
+        // The case-insensitive operations use the simple case folding (so "ß" does not equal "ss") and never
+        // allocate.
+        [[nodiscard]] bool equals_ignore_case(Utf8StringView other) const;
+        [[nodiscard]] std::weak_ordering compare_ignore_case(Utf8StringView other) const;
+
         [[nodiscard]] Utf8Char front() const;
         [[nodiscard]] Utf8Char back() const;
 
@@ -109,28 +136,67 @@ namespace c2k {
             return rend();
         }
 
+        [[nodiscard]] Utf8CodepointRange codepoints() const {
+            return Utf8CodepointRange{ m_view };
+        }
+
+        [[nodiscard]] Utf8CharSpanRange char_spans() const {
+            return Utf8CharSpanRange{ m_view };
+        }
+
+        [[nodiscard]] Utf8GraphemeRange graphemes() const {
+            return Utf8GraphemeRange{ m_view };
+        }
+
         [[nodiscard]] ConstIterator find(Utf8Char needle) const;
         [[nodiscard]] ConstIterator find(Utf8Char needle, ConstIterator const& start) const;
         [[nodiscard]] ConstIterator find(Utf8Char needle, ConstIterator::difference_type start_position) const;
         [[nodiscard]] ConstIterator find(Utf8StringView needle) const;
         [[nodiscard]] ConstIterator find(Utf8StringView needle, ConstIterator const& start) const;
         [[nodiscard]] ConstIterator find(Utf8StringView needle, ConstIterator::difference_type start_position) const;
+        [[nodiscard]] ConstIterator find(Utf8Searcher const& searcher) const;
+        [[nodiscard]] ConstIterator find(Utf8Searcher const& searcher, ConstIterator const& start) const;
+
+        [[nodiscard]] Utf8String to_uppercase() const;
+        [[nodiscard]] Utf8String to_lowercase() const;
 
         [[nodiscard]] Utf8String join(Iterable<Utf8StringView> auto const& iterable) const {
-            if (std::cbegin(iterable) == std::cend(iterable)) {
-                return {};
-            }
-            auto it = std::cbegin(iterable);
-            auto result = Utf8String{ *it };
-            ++it;
-            for (; it != std::cend(iterable); ++it) {
-                result += *this;
-                result += *it;
+            auto builder = Utf8StringBuilder{};
+            auto is_first = true;
+            for (auto const& part : iterable) {
+                if constexpr (std::same_as<std::decay_t<decltype(part)>, char const*>) {
+                    if (part == nullptr) {
+                        throw std::invalid_argument{ "cannot join nullptr c-strings" };
+                    }
+                }
+                if (not is_first) {
+                    builder.append(*this);
+                }
+                builder.append(Utf8StringView{ part });
+                is_first = false;
             }
-            return result;
+            return builder.finish();
         }
 
         [[nodiscard]] std::vector<Utf8StringView> split(Utf8StringView delimiter) const;
+        // clang-format off
+        [[nodiscard]] std::pmr::vector<Utf8StringView> split(
+            Utf8StringView delimiter,
+            std::pmr::memory_resource* resource
+        ) const; // clang-format on
+        [[nodiscard]] std::vector<Utf8StringView> split(Utf8Searcher const& delimiter) const;
+
+        // Finds the next delimiter only when the iterator is advanced. The view refers to the same data as this.
+        [[nodiscard]] Utf8SplitView split_view(Utf8StringView delimiter) const;
+
+        // Replace the contents of `result` (but keep its capacity).
+        void split_into(Utf8StringView delimiter, std::vector<Utf8StringView>& result) const;
+        void split_into(Utf8Searcher const& delimiter, std::vector<Utf8StringView>& result) const;
+
+        // Splits at every occurrence of any of the chars of `delimiters` and skips empty tokens. Both this and
+        // `delimiters` have to outlive the returned view.
+        [[nodiscard]] Utf8TokenView tokenize(Utf8StringView delimiters) const;
+        void tokenize_into(Utf8StringView delimiters, std::vector<TokenSpan>& result) const;
 
         // clang-format off
         [[nodiscard]] Utf8String replace(
@@ -175,6 +241,35 @@ namespace c2k {
         ) const { // clang-format on
             return replace(to_replace, replacement, cbegin(), max_num_replacements);
         }
+
+        [[nodiscard]] Utf8String replace(Utf8Searcher const& to_replace, Utf8StringView replacement) const;
+
+        // clang-format off
+        [[nodiscard]] Utf8String replace(
+            Utf8Searcher const& to_replace,
+            Utf8StringView replacement,
+            MaxReplacementCount max_num_replacements
+        ) const; // clang-format on
+
+    private:
+        // Stops at end() if fewer than `num_chars` chars follow `iterator`.
+        [[nodiscard]] ConstIterator advanced(ConstIterator const& iterator, std::size_t num_chars) const;
+    };
+
+    // Hash and equality functors for case-insensitive keys in unordered containers. Both are transparent, so
+    // lookups with a Utf8StringView do not have to create a Utf8String.
+    struct CaseInsensitiveHash final {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(Utf8StringView view) const;
+    };
+
+    struct CaseInsensitiveEqual final {
+        using is_transparent = void;
+
+        [[nodiscard]] bool operator()(Utf8StringView const lhs, Utf8StringView const rhs) const {
+            return lhs.equals_ignore_case(rhs);
+        }
     };
 
     namespace Utf8Literals {
@@ -182,6 +277,10 @@ namespace c2k {
     }
 } // namespace c2k
 
+static_assert(std::forward_iterator<c2k::Utf8SplitView::Iterator>);
+static_assert(std::ranges::view<c2k::Utf8SplitView>);
+static_assert(std::forward_iterator<c2k::Utf8TokenView::Iterator>);
+
 template<>
 struct std::hash<c2k::Utf8StringView> {
     [[nodiscard]] std::size_t operator()(c2k::Utf8StringView const& view) const noexcept {
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "errors.hpp"
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tl/expected.hpp>
+
+namespace c2k {
+    class Utf8String;
+    class Utf8StringView;
+
+    // The number of code units that are needed to transcode `source` into the respective encoding.
+    [[nodiscard]] std::size_t utf16_length(Utf8StringView source);
+    [[nodiscard]] std::size_t utf32_length(Utf8StringView source);
+
+    // The overloads that write into a span throw std::length_error if the destination is too small and
+    // return the number of code units written otherwise.
+    [[nodiscard]] std::size_t transcode_to_utf16(Utf8StringView source, std::span<char16_t> destination);
+    [[nodiscard]] std::u16string transcode_to_utf16(Utf8StringView source);
+    [[nodiscard]] std::size_t transcode_to_utf32(Utf8StringView source, std::span<char32_t> destination);
+    [[nodiscard]] std::u32string transcode_to_utf32(Utf8StringView source);
+
+    // The input is validated while transcoding. Unpaired surrogates and code points that are out of range are
+    // reported as errors.
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> utf8_length(std::u16string_view source);
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> utf8_length(std::u32string_view source);
+    // clang-format off
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> transcode_from_utf16(
+        std::u16string_view source,
+        std::span<char> destination
+    );
+    [[nodiscard]] tl::expected<Utf8String, Utf8Error> transcode_from_utf16(std::u16string_view source);
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> transcode_from_utf32(
+        std::u32string_view source,
+        std::span<char> destination
+    ); // clang-format on
+    [[nodiscard]] tl::expected<Utf8String, Utf8Error> transcode_from_utf32(std::u32string_view source);
+} // namespace c2k
@@ -0,0 +1,182 @@
+#include <lib2k/multi_pattern_matcher.hpp>
+#include <lib2k/utf8/errors.hpp>
+#include <queue>
+#include <stdexcept>
+
+namespace c2k {
+    MultiPatternMatcher::MultiPatternMatcher(std::vector<std::string> patterns) : m_patterns{ std::move(patterns) } {
+        build();
+    }
+
+    // clang-format off
+    MultiPatternMatcher::MultiPatternMatcher(
+        std::vector<std::pair<std::string, std::string>> patterns_and_replacements
+    ) { // clang-format on
+        m_patterns.reserve(patterns_and_replacements.size());
+        m_replacements.reserve(patterns_and_replacements.size());
+        for (auto& [pattern, replacement] : patterns_and_replacements) {
+            m_patterns.push_back(std::move(pattern));
+            m_replacements.push_back(std::move(replacement));
+        }
+        build();
+    }
+
+    template<typename Callback>
+    void MultiPatternMatcher::for_each_match(std::string_view const text, Callback&& callback) const {
+        // A match is only reported once no match can start at the same position or before it anymore: every
+        // match that ends later has to start within the pattern prefix that the current state represents.
+        // After reporting a match, the search restarts at its end, so that matches do not overlap. This also
+        // applies at the end of the text, since the bytes after a pending match may contain further matches.
+        auto state = std::uint32_t{ 0 };
+        auto pending = PatternMatch{ no_match, 0, 0 };
+        auto i = std::size_t{ 0 };
+        while (i < text.size() or pending.pattern_index != no_match) {
+            if (i < text.size()) {
+                state = transition(state, text[i]);
+                ++i;
+                if (auto const index = m_matches[state]; index != no_match) {
+                    auto const length = m_patterns[index].size();
+                    if (pending.pattern_index == no_match or i - length <= pending.offset) {
+                        pending = PatternMatch{ index, i - length, length };
+                    }
+                }
+            }
+            if (pending.pattern_index != no_match and (i == text.size() or i - m_depths[state] > pending.offset)) {
+                callback(pending);
+                i = pending.offset + pending.length;
+                state = 0;
+                pending.pattern_index = no_match;
+            }
+        }
+    }
+
+    [[nodiscard]] std::vector<PatternMatch> MultiPatternMatcher::find_all(std::string_view const text) const {
+        auto result = std::vector<PatternMatch>{};
+        for_each_match(text, [&](PatternMatch const& match) { result.push_back(match); });
+        return result;
+    }
+
+    [[nodiscard]] bool MultiPatternMatcher::contains_any(std::string_view const text) const {
+        // any match will do, so there is no need to determine the leftmost one
+        auto state = std::uint32_t{ 0 };
+        for (auto const c : text) {
+            state = transition(state, c);
+            if (m_matches[state] != no_match) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    [[nodiscard]] std::string MultiPatternMatcher::replace_all(std::string_view const text) const {
+        if (m_replacements.empty() and not m_patterns.empty()) {
+            throw std::logic_error{ "cannot replace without replacements" };
+        }
+        auto const matches = find_all(text);
+        auto result_size = text.size();
+        for (auto const& match : matches) {
+            result_size = result_size - match.length + m_replacements[match.pattern_index].size();
+        }
+
+        auto result = std::string{};
+        result.reserve(result_size);
+        auto previous = std::size_t{ 0 };
+        for (auto const& match : matches) {
+            result.append(text.substr(previous, match.offset - previous));
+            result.append(m_replacements[match.pattern_index]);
+            previous = match.offset + match.length;
+        }
+        result.append(text.substr(previous));
+        return result;
+    }
+
+    [[nodiscard]] Utf8String MultiPatternMatcher::replace_all(Utf8StringView const text) const {
+        auto result = replace_all(text.view());
+        if (m_is_utf8) {
+            return Utf8String::from_string_unchecked(std::move(result));
+        }
+        auto validated = Utf8String::from_chars(std::move(result));
+        if (not validated.has_value()) {
+            throw InvalidUtf8String{};
+        }
+        return std::move(validated).value();
+    }
+
+    void MultiPatternMatcher::build() {
+        for (auto const& pattern : m_patterns) {
+            if (pattern.empty()) {
+                throw std::invalid_argument{ "cannot match empty pattern" };
+            }
+            m_is_utf8 = m_is_utf8 and Utf8String::is_valid_utf8(pattern);
+            for (auto const c : pattern) {
+                auto& byte_class = m_byte_classes[static_cast<std::uint8_t>(c)];
+                if (byte_class == 0) {
+                    byte_class = static_cast<std::uint16_t>(m_num_byte_classes++);
+                }
+            }
+        }
+        for (auto const& replacement : m_replacements) {
+            m_is_utf8 = m_is_utf8 and Utf8String::is_valid_utf8(replacement);
+        }
+
+        // trie of all patterns (missing transitions are filled in below)
+        auto const add_state = [&](std::uint32_t const depth) {
+            auto const state = static_cast<std::uint32_t>(m_depths.size());
+            m_transitions.resize(m_transitions.size() + m_num_byte_classes, no_match);
+            m_depths.push_back(depth);
+            m_matches.push_back(no_match);
+            return state;
+        };
+        add_state(0);
+        for (auto index = std::size_t{ 0 }; index < m_patterns.size(); ++index) {
+            auto state = std::uint32_t{ 0 };
+            for (auto const c : m_patterns[index]) {
+                auto const slot = state * m_num_byte_classes + m_byte_classes[static_cast<std::uint8_t>(c)];
+                if (m_transitions[slot] == no_match) {
+                    auto const next = add_state(m_depths[state] + 1);
+                    m_transitions[slot] = next;
+                }
+                state = m_transitions[slot];
+            }
+            if (m_matches[state] == no_match) {
+                m_matches[state] = static_cast<std::uint32_t>(index);
+            }
+        }
+
+        // Breadth-first traversal to compute the failure links. Missing transitions are replaced by the
+        // transitions of the failure state, which turns the trie into a DFA.
+        auto failure_links = std::vector<std::uint32_t>(m_depths.size(), 0);
+        auto queue = std::queue<std::uint32_t>{};
+        for (auto byte_class = std::size_t{ 0 }; byte_class < m_num_byte_classes; ++byte_class) {
+            auto& next = m_transitions[byte_class];
+            if (next == no_match) {
+                next = 0;
+            } else {
+                queue.push(next);
+            }
+        }
+        while (not queue.empty()) {
+            auto const state = queue.front();
+            queue.pop();
+            auto const failure_link = failure_links[state];
+            if (m_matches[state] == no_match) {
+                // the longest pattern that ends here is a suffix of the current prefix
+                m_matches[state] = m_matches[failure_link];
+            }
+            for (auto byte_class = std::size_t{ 0 }; byte_class < m_num_byte_classes; ++byte_class) {
+                auto& next = m_transitions[state * m_num_byte_classes + byte_class];
+                auto const fallback = m_transitions[failure_link * m_num_byte_classes + byte_class];
+                if (next == no_match) {
+                    next = fallback;
+                } else {
+                    failure_links[next] = fallback;
+                    queue.push(next);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] std::uint32_t MultiPatternMatcher::transition(std::uint32_t const state, char const byte) const {
+        return m_transitions[state * m_num_byte_classes + m_byte_classes[static_cast<std::uint8_t>(byte)]];
+    }
+} // namespace c2k
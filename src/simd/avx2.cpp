@@ -0,0 +1,244 @@
+#include "generic_kernels.hpp"
+#include "simd.hpp"
+#include "utf8_validation.hpp"
+#include <immintrin.h>
+
+namespace c2k::detail::simd::avx2 {
+    namespace {
+        struct Ops final {
+            using Register = __m256i;
+            static constexpr auto register_size = sizeof(Register);
+
+            [[nodiscard]] static Register zero() {
+                return _mm256_setzero_si256();
+            }
+
+            [[nodiscard]] static Register splat(std::uint8_t const value) {
+                return _mm256_set1_epi8(static_cast<char>(value));
+            }
+
+            [[nodiscard]] static Register load(std::uint8_t const* const data) {
+                return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(data));
+            }
+
+            static void store(std::uint8_t* const data, Register const value) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value);
+            }
+
+            // signed comparison
+            [[nodiscard]] static Register greater_than(Register const lhs, Register const rhs) {
+                return _mm256_cmpgt_epi8(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register table(std::uint8_t const (&values)[16]) {
+                return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<__m128i const*>(values)));
+            }
+
+            [[nodiscard]] static Register lookup(Register const table, Register const indices) {
+                return _mm256_shuffle_epi8(table, indices);
+            }
+
+            [[nodiscard]] static Register high_nibbles(Register const value) {
+                return _mm256_and_si256(_mm256_srli_epi16(value, 4), splat(0x0F));
+            }
+
+            [[nodiscard]] static Register low_nibbles(Register const value) {
+                return _mm256_and_si256(value, splat(0x0F));
+            }
+
+            [[nodiscard]] static Register bit_and(Register const lhs, Register const rhs) {
+                return _mm256_and_si256(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_or(Register const lhs, Register const rhs) {
+                return _mm256_or_si256(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_xor(Register const lhs, Register const rhs) {
+                return _mm256_xor_si256(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register saturating_sub(Register const lhs, Register const rhs) {
+                return _mm256_subs_epu8(lhs, rhs);
+            }
+
+            // shifts in the last `N` bytes of `previous_input`
+            template<int N>
+            [[nodiscard]] static Register previous(Register const input, Register const previous_input) {
+                return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous_input, input, 0x21), 16 - N);
+            }
+
+            [[nodiscard]] static bool is_ascii(Register const value) {
+                return _mm256_movemask_epi8(value) == 0;
+            }
+
+            [[nodiscard]] static bool is_zero(Register const value) {
+                return _mm256_testz_si256(value, value) != 0;
+            }
+
+            [[nodiscard]] static std::size_t count_high_bits(Register const value) {
+                return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned int>(_mm256_movemask_epi8(value))));
+            }
+
+            // The widening and narrowing operations process `register_size` code units at once.
+            static void store_widened(Register const value, char16_t* const destination) {
+                auto const output = reinterpret_cast<__m256i*>(destination);
+                _mm256_storeu_si256(output, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(value)));
+                _mm256_storeu_si256(output + 1, _mm256_cvtepu8_epi16(_mm256_extracti128_si256(value, 1)));
+            }
+
+            static void store_widened(Register const value, char32_t* const destination) {
+                auto const output = reinterpret_cast<__m256i*>(destination);
+                auto const low = _mm256_castsi256_si128(value);
+                auto const high = _mm256_extracti128_si256(value, 1);
+                _mm256_storeu_si256(output, _mm256_cvtepu8_epi32(low));
+                _mm256_storeu_si256(output + 1, _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+                _mm256_storeu_si256(output + 2, _mm256_cvtepu8_epi32(high));
+                _mm256_storeu_si256(output + 3, _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+            }
+
+            // Returns false (and leaves `result` untouched) if not all code units are ASCII. Since the pack
+            // instructions operate on 128-bit lanes, the results have to be reordered.
+            [[nodiscard]] static bool load_narrowed(char16_t const* const source, Register& result) {
+                auto const input = reinterpret_cast<__m256i const*>(source);
+                auto const low = _mm256_loadu_si256(input);
+                auto const high = _mm256_loadu_si256(input + 1);
+                auto const non_ascii_bits = _mm256_set1_epi16(static_cast<short>(0xFF80));
+                if (_mm256_testz_si256(_mm256_or_si256(low, high), non_ascii_bits) == 0) {
+                    return false;
+                }
+                result = _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0b11'01'10'00);
+                return true;
+            }
+
+            [[nodiscard]] static bool load_narrowed(char32_t const* const source, Register& result) {
+                auto const input = reinterpret_cast<__m256i const*>(source);
+                auto const first = _mm256_loadu_si256(input);
+                auto const second = _mm256_loadu_si256(input + 1);
+                auto const third = _mm256_loadu_si256(input + 2);
+                auto const fourth = _mm256_loadu_si256(input + 3);
+                auto const combined = _mm256_or_si256(_mm256_or_si256(first, second), _mm256_or_si256(third, fourth));
+                if (_mm256_testz_si256(combined, _mm256_set1_epi32(static_cast<int>(0xFFFF'FF80))) == 0) {
+                    return false;
+                }
+                auto const packed =
+                        _mm256_packus_epi16(_mm256_packus_epi32(first, second), _mm256_packus_epi32(third, fourth));
+                result = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+                return true;
+            }
+
+            // continuation bytes are the only bytes that are less than 0b1100'0000 when interpreted as signed values
+            [[nodiscard]] static std::size_t count_continuation_bytes(Register const value) {
+                auto const mask = _mm256_movemask_epi8(_mm256_cmpgt_epi8(splat(0b1100'0000), value));
+                return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned int>(mask)));
+            }
+
+            [[nodiscard]] static std::uint64_t equal_mask(Register const lhs, Register const rhs) {
+                auto const mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(lhs, rhs));
+                return static_cast<std::uint64_t>(static_cast<unsigned int>(mask));
+            }
+
+            [[nodiscard]] static std::size_t lowest_set_bit(std::uint64_t const mask) {
+                return static_cast<std::size_t>(_tzcnt_u64(mask));
+            }
+        };
+    } // namespace
+
+    [[nodiscard]] Utf8ValidationResult validate_utf8(char const* const data, std::size_t const length) {
+        return simd::validate_utf8<Ops>(data, length);
+    }
+
+    [[nodiscard]] bool is_ascii(char const* const data, std::size_t const length) {
+        return simd::is_ascii<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t ascii_prefix_length(char const* const data, std::size_t const length) {
+        return simd::ascii_prefix_length<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t count_chars(char const* const data, std::size_t const length) {
+        return simd::count_chars<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t convert_ascii_case(
+        char const* const source,
+        std::size_t const length,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        return simd::convert_ascii_case<Ops>(source, length, destination, target);
+    }
+
+    [[nodiscard]] AsciiWidth measure_ascii_width(char const* const data, std::size_t const length) {
+        return simd::measure_ascii_width<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        char const* const lhs,
+        char const* const rhs,
+        std::size_t const length
+    ) { // clang-format on
+        return simd::ascii_common_prefix_ignore_case<Ops>(lhs, rhs, length);
+    }
+
+    [[nodiscard]] std::size_t count_utf16_code_units(char const* const data, std::size_t const length) {
+        return simd::count_utf16_code_units<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf16(
+        char const* const source,
+        std::size_t const length,
+        char16_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf32(
+        char const* const source,
+        std::size_t const length,
+        char32_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+        char16_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+        char32_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_substring(
+        char const* const haystack,
+        std::size_t const length,
+        char const* const needle,
+        std::size_t const needle_length
+    ) { // clang-format on
+        return simd::find_substring<Ops>(haystack, length, needle, needle_length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_nibble_match(
+        char const* const data,
+        std::size_t const length,
+        NibbleTables const& tables
+    ) { // clang-format on
+        return simd::find_nibble_match<Ops>(data, length, tables);
+    }
+} // namespace c2k::detail::simd::avx2
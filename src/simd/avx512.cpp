@@ -0,0 +1,245 @@
+#include "generic_kernels.hpp"
+#include "simd.hpp"
+#include "utf8_validation.hpp"
+#include <immintrin.h>
+
+namespace c2k::detail::simd::avx512 {
+    namespace {
+        struct Ops final {
+            using Register = __m512i;
+            static constexpr auto register_size = sizeof(Register);
+
+            [[nodiscard]] static Register zero() {
+                return _mm512_setzero_si512();
+            }
+
+            [[nodiscard]] static Register splat(std::uint8_t const value) {
+                return _mm512_set1_epi8(static_cast<char>(value));
+            }
+
+            [[nodiscard]] static Register load(std::uint8_t const* const data) {
+                return _mm512_loadu_si512(data);
+            }
+
+            static void store(std::uint8_t* const data, Register const value) {
+                _mm512_storeu_si512(data, value);
+            }
+
+            // signed comparison
+            [[nodiscard]] static Register greater_than(Register const lhs, Register const rhs) {
+                return _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(lhs, rhs));
+            }
+
+            [[nodiscard]] static Register table(std::uint8_t const (&values)[16]) {
+                return _mm512_broadcast_i32x4(_mm_loadu_si128(reinterpret_cast<__m128i const*>(values)));
+            }
+
+            [[nodiscard]] static Register lookup(Register const table, Register const indices) {
+                return _mm512_shuffle_epi8(table, indices);
+            }
+
+            [[nodiscard]] static Register high_nibbles(Register const value) {
+                return _mm512_and_si512(_mm512_srli_epi16(value, 4), splat(0x0F));
+            }
+
+            [[nodiscard]] static Register low_nibbles(Register const value) {
+                return _mm512_and_si512(value, splat(0x0F));
+            }
+
+            [[nodiscard]] static Register bit_and(Register const lhs, Register const rhs) {
+                return _mm512_and_si512(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_or(Register const lhs, Register const rhs) {
+                return _mm512_or_si512(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_xor(Register const lhs, Register const rhs) {
+                return _mm512_xor_si512(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register saturating_sub(Register const lhs, Register const rhs) {
+                return _mm512_subs_epu8(lhs, rhs);
+            }
+
+            // shifts in the last `N` bytes of `previous_input`
+            template<int N>
+            [[nodiscard]] static Register previous(Register const input, Register const previous_input) {
+                // [last lane of previous_input, lanes 0 to 2 of input]
+                auto const lane_indices = _mm512_setr_epi32(28, 29, 30, 31, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11);
+                auto const rotated = _mm512_permutex2var_epi32(input, lane_indices, previous_input);
+                return _mm512_alignr_epi8(input, rotated, 16 - N);
+            }
+
+            [[nodiscard]] static bool is_ascii(Register const value) {
+                return _mm512_movepi8_mask(value) == 0;
+            }
+
+            [[nodiscard]] static bool is_zero(Register const value) {
+                return _mm512_test_epi8_mask(value, value) == 0;
+            }
+
+            [[nodiscard]] static std::size_t count_high_bits(Register const value) {
+                return static_cast<std::size_t>(_mm_popcnt_u64(_mm512_movepi8_mask(value)));
+            }
+
+            // The widening and narrowing operations process `register_size` code units at once.
+            static void store_widened(Register const value, char16_t* const destination) {
+                auto const output = reinterpret_cast<__m512i*>(destination);
+                _mm512_storeu_si512(output, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(value)));
+                _mm512_storeu_si512(output + 1, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(value, 1)));
+            }
+
+            static void store_widened(Register const value, char32_t* const destination) {
+                auto const output = reinterpret_cast<__m512i*>(destination);
+                _mm512_storeu_si512(output, _mm512_cvtepu8_epi32(_mm512_castsi512_si128(value)));
+                _mm512_storeu_si512(output + 1, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(value, 1)));
+                _mm512_storeu_si512(output + 2, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(value, 2)));
+                _mm512_storeu_si512(output + 3, _mm512_cvtepu8_epi32(_mm512_extracti32x4_epi32(value, 3)));
+            }
+
+            // returns false (and leaves `result` untouched) if not all code units are ASCII
+            [[nodiscard]] static bool load_narrowed(char16_t const* const source, Register& result) {
+                auto const low = _mm512_loadu_si512(source);
+                auto const high = _mm512_loadu_si512(source + 32);
+                auto const non_ascii_bits = _mm512_set1_epi16(static_cast<short>(0xFF80));
+                if (_mm512_test_epi16_mask(_mm512_or_si512(low, high), non_ascii_bits) != 0) {
+                    return false;
+                }
+                result = _mm512_inserti64x4(
+                        _mm512_castsi256_si512(_mm512_cvtepi16_epi8(low)),
+                        _mm512_cvtepi16_epi8(high),
+                        1
+                );
+                return true;
+            }
+
+            [[nodiscard]] static bool load_narrowed(char32_t const* const source, Register& result) {
+                auto const first = _mm512_loadu_si512(source);
+                auto const second = _mm512_loadu_si512(source + 16);
+                auto const third = _mm512_loadu_si512(source + 32);
+                auto const fourth = _mm512_loadu_si512(source + 48);
+                auto const combined = _mm512_or_si512(_mm512_or_si512(first, second), _mm512_or_si512(third, fourth));
+                if (_mm512_test_epi32_mask(combined, _mm512_set1_epi32(static_cast<int>(0xFFFF'FF80))) != 0) {
+                    return false;
+                }
+                result = _mm512_castsi128_si512(_mm512_cvtepi32_epi8(first));
+                result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(second), 1);
+                result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(third), 2);
+                result = _mm512_inserti32x4(result, _mm512_cvtepi32_epi8(fourth), 3);
+                return true;
+            }
+
+            // continuation bytes are the only bytes that are less than 0b1100'0000 when interpreted as signed values
+            [[nodiscard]] static std::size_t count_continuation_bytes(Register const value) {
+                return static_cast<std::size_t>(_mm_popcnt_u64(_mm512_cmplt_epi8_mask(value, splat(0b1100'0000))));
+            }
+
+            [[nodiscard]] static std::uint64_t equal_mask(Register const lhs, Register const rhs) {
+                return _mm512_cmpeq_epi8_mask(lhs, rhs);
+            }
+
+            [[nodiscard]] static std::size_t lowest_set_bit(std::uint64_t const mask) {
+                return static_cast<std::size_t>(_tzcnt_u64(mask));
+            }
+        };
+    } // namespace
+
+    [[nodiscard]] Utf8ValidationResult validate_utf8(char const* const data, std::size_t const length) {
+        return simd::validate_utf8<Ops>(data, length);
+    }
+
+    [[nodiscard]] bool is_ascii(char const* const data, std::size_t const length) {
+        return simd::is_ascii<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t ascii_prefix_length(char const* const data, std::size_t const length) {
+        return simd::ascii_prefix_length<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t count_chars(char const* const data, std::size_t const length) {
+        return simd::count_chars<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t convert_ascii_case(
+        char const* const source,
+        std::size_t const length,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        return simd::convert_ascii_case<Ops>(source, length, destination, target);
+    }
+
+    [[nodiscard]] AsciiWidth measure_ascii_width(char const* const data, std::size_t const length) {
+        return simd::measure_ascii_width<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        char const* const lhs,
+        char const* const rhs,
+        std::size_t const length
+    ) { // clang-format on
+        return simd::ascii_common_prefix_ignore_case<Ops>(lhs, rhs, length);
+    }
+
+    [[nodiscard]] std::size_t count_utf16_code_units(char const* const data, std::size_t const length) {
+        return simd::count_utf16_code_units<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf16(
+        char const* const source,
+        std::size_t const length,
+        char16_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf32(
+        char const* const source,
+        std::size_t const length,
+        char32_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+        char16_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+        char32_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_substring(
+        char const* const haystack,
+        std::size_t const length,
+        char const* const needle,
+        std::size_t const needle_length
+    ) { // clang-format on
+        return simd::find_substring<Ops>(haystack, length, needle, needle_length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_nibble_match(
+        char const* const data,
+        std::size_t const length,
+        NibbleTables const& tables
+    ) { // clang-format on
+        return simd::find_nibble_match<Ops>(data, length, tables);
+    }
+} // namespace c2k::detail::simd::avx512
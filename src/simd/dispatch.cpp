@@ -0,0 +1,187 @@
+#include "simd.hpp"
+#include <algorithm>
+
+#if defined(LIB2K_SIMD_X86) and defined(_MSC_VER) and not defined(__clang__)
+#include <array>
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+// clang-format off
+#define LIB2K_MAKE_KERNELS(InstructionSetValue, Namespace) \
+    Kernels {                                              \
+        InstructionSetValue,                               \
+        Namespace::validate_utf8,                          \
+        Namespace::is_ascii,                               \
+        Namespace::ascii_prefix_length,                    \
+        Namespace::count_chars,                            \
+        Namespace::convert_ascii_case,                     \
+        Namespace::measure_ascii_width,                    \
+        Namespace::ascii_common_prefix_ignore_case,        \
+        Namespace::count_utf16_code_units,                 \
+        Namespace::widen_ascii_to_utf16,                   \
+        Namespace::widen_ascii_to_utf32,                   \
+        Namespace::narrow_ascii_from_utf16,                \
+        Namespace::narrow_ascii_from_utf32,                \
+        Namespace::find_substring,                         \
+        Namespace::find_nibble_match,                      \
+    }
+// clang-format on
+
+namespace c2k::detail::simd {
+    namespace {
+#ifdef LIB2K_SIMD_X86
+#if defined(_MSC_VER) and not defined(__clang__)
+        [[nodiscard]] bool is_bit_set(int const value, int const bit) {
+            return (static_cast<unsigned int>(value) & (1U << bit)) != 0;
+        }
+
+        [[nodiscard]] InstructionSet detect_instruction_set() {
+            auto registers = std::array<int, 4>{};
+            __cpuid(registers.data(), 0);
+            auto const max_leaf = registers[0];
+
+            __cpuid(registers.data(), 1);
+            auto const leaf_1_ecx = registers[2];
+            auto const has_sse4 = is_bit_set(leaf_1_ecx, 19) and is_bit_set(leaf_1_ecx, 20)
+                                  and is_bit_set(leaf_1_ecx, 23);
+            if (not has_sse4) {
+                return InstructionSet::Scalar;
+            }
+            auto const has_os_avx_support = is_bit_set(leaf_1_ecx, 27) and is_bit_set(leaf_1_ecx, 28)
+                                            and (_xgetbv(0) & 0b110) == 0b110;
+            if (max_leaf < 7 or not has_os_avx_support) {
+                return InstructionSet::Sse4;
+            }
+
+            __cpuidex(registers.data(), 7, 0);
+            auto const leaf_7_ebx = registers[1];
+            auto const has_avx2 = is_bit_set(leaf_7_ebx, 5) and is_bit_set(leaf_7_ebx, 3)
+                                  and is_bit_set(leaf_7_ebx, 8);
+            if (not has_avx2) {
+                return InstructionSet::Sse4;
+            }
+            auto const has_os_avx512_support = (_xgetbv(0) & 0b1110'0110) == 0b1110'0110;
+            auto const has_avx512 = is_bit_set(leaf_7_ebx, 16) and is_bit_set(leaf_7_ebx, 30)
+                                    and is_bit_set(leaf_7_ebx, 31);
+            if (not has_os_avx512_support or not has_avx512) {
+                return InstructionSet::Avx2;
+            }
+            return InstructionSet::Avx512;
+        }
+#else
+        [[nodiscard]] InstructionSet detect_instruction_set() {
+            __builtin_cpu_init();
+            if (not __builtin_cpu_supports("sse4.2") or not __builtin_cpu_supports("popcnt")) {
+                return InstructionSet::Scalar;
+            }
+            if (not __builtin_cpu_supports("avx2") or not __builtin_cpu_supports("bmi")
+                or not __builtin_cpu_supports("bmi2")) {
+                return InstructionSet::Sse4;
+            }
+            if (not __builtin_cpu_supports("avx512f") or not __builtin_cpu_supports("avx512bw")
+                or not __builtin_cpu_supports("avx512vl")) {
+                return InstructionSet::Avx2;
+            }
+            return InstructionSet::Avx512;
+        }
+#endif
+#else
+        [[nodiscard]] InstructionSet detect_instruction_set() {
+            return InstructionSet::Scalar;
+        }
+#endif
+
+        [[nodiscard]] Kernels const& kernels() {
+            static auto const result = kernels_for(detect_instruction_set());
+            return result;
+        }
+    } // namespace
+
+    [[nodiscard]] InstructionSet active_instruction_set() {
+        return kernels().instruction_set;
+    }
+
+    [[nodiscard]] Kernels kernels_for([[maybe_unused]] InstructionSet const instruction_set) {
+#ifdef LIB2K_SIMD_X86
+        switch (instruction_set) {
+            case InstructionSet::Avx512:
+                return LIB2K_MAKE_KERNELS(InstructionSet::Avx512, avx512);
+            case InstructionSet::Avx2:
+                return LIB2K_MAKE_KERNELS(InstructionSet::Avx2, avx2);
+            case InstructionSet::Sse4:
+                return LIB2K_MAKE_KERNELS(InstructionSet::Sse4, sse4);
+            case InstructionSet::Scalar:
+                break;
+        }
+#endif
+        return LIB2K_MAKE_KERNELS(InstructionSet::Scalar, scalar);
+    }
+
+    [[nodiscard]] Utf8ValidationResult validate_utf8(std::string_view const string) {
+        return kernels().validate_utf8(string.data(), string.size());
+    }
+
+    [[nodiscard]] bool is_ascii(std::string_view const string) {
+        return kernels().is_ascii(string.data(), string.size());
+    }
+
+    [[nodiscard]] std::size_t ascii_prefix_length(std::string_view const string) {
+        return kernels().ascii_prefix_length(string.data(), string.size());
+    }
+
+    [[nodiscard]] std::size_t count_chars(std::string_view const string) {
+        return kernels().count_chars(string.data(), string.size());
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t convert_ascii_case(
+        std::string_view const source,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        return kernels().convert_ascii_case(source.data(), source.size(), destination, target);
+    }
+
+    [[nodiscard]] AsciiWidth measure_ascii_width(std::string_view const string) {
+        return kernels().measure_ascii_width(string.data(), string.size());
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        std::string_view const lhs,
+        std::string_view const rhs
+    ) { // clang-format on
+        return kernels().ascii_common_prefix_ignore_case(lhs.data(), rhs.data(), std::min(lhs.size(), rhs.size()));
+    }
+
+    [[nodiscard]] std::size_t count_utf16_code_units(std::string_view const string) {
+        return kernels().count_utf16_code_units(string.data(), string.size());
+    }
+
+    [[nodiscard]] std::size_t widen_ascii(std::string_view const source, char16_t* const destination) {
+        return kernels().widen_ascii_to_utf16(source.data(), source.size(), destination);
+    }
+
+    [[nodiscard]] std::size_t widen_ascii(std::string_view const source, char32_t* const destination) {
+        return kernels().widen_ascii_to_utf32(source.data(), source.size(), destination);
+    }
+
+    [[nodiscard]] std::size_t narrow_ascii(std::u16string_view const source, char* const destination) {
+        return kernels().narrow_ascii_from_utf16(source.data(), source.size(), destination);
+    }
+
+    [[nodiscard]] std::size_t narrow_ascii(std::u32string_view const source, char* const destination) {
+        return kernels().narrow_ascii_from_utf32(source.data(), source.size(), destination);
+    }
+
+    [[nodiscard]] std::size_t find_substring(std::string_view const haystack, std::string_view const needle) {
+        auto const position = kernels().find_substring(haystack.data(), haystack.size(), needle.data(), needle.size());
+        return (position == haystack.size() and not needle.empty()) ? std::string_view::npos : position;
+    }
+
+    [[nodiscard]] std::size_t find_nibble_match(std::string_view const string, NibbleTables const& tables) {
+        auto const position = kernels().find_nibble_match(string.data(), string.size(), tables);
+        return position == string.size() ? std::string_view::npos : position;
+    }
+} // namespace c2k::detail::simd
@@ -0,0 +1,303 @@
+#pragma once
+
+// Kernels that are written once and instantiated per instruction set. `Ops` provides the register type and
+// the primitive operations for one instruction set (see utf8_validation.hpp for the reasoning behind this
+// approach).
+
+#include "utf8_validation.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace c2k::detail::simd {
+    template<typename Ops>
+    [[nodiscard]] bool is_ascii(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= block_size; i += block_size) {
+            auto combined = Ops::zero();
+            for (auto offset = std::size_t{ 0 }; offset < block_size; offset += Ops::register_size) {
+                combined = Ops::bit_or(combined, Ops::load(bytes + i + offset));
+            }
+            if (not Ops::is_ascii(combined)) {
+                return false;
+            }
+        }
+        for (; i < length; ++i) {
+            if (bytes[i] >= 0x80) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template<typename Ops>
+    [[nodiscard]] std::size_t ascii_prefix_length(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            if (not Ops::is_ascii(Ops::load(bytes + i))) {
+                break;
+            }
+        }
+        while (i < length and bytes[i] < 0x80) {
+            ++i;
+        }
+        return i;
+    }
+
+    template<typename Ops>
+    [[nodiscard]] std::size_t count_chars(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto num_continuation_bytes = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            num_continuation_bytes += Ops::count_continuation_bytes(Ops::load(bytes + i));
+        }
+        for (; i < length; ++i) {
+            if ((bytes[i] & 0b1100'0000) == 0b1000'0000) {
+                ++num_continuation_bytes;
+            }
+        }
+        return length - num_continuation_bytes;
+    }
+
+    // clang-format off
+    template<typename Ops>
+    [[nodiscard]] std::size_t convert_ascii_case(
+        char const* const source,
+        std::size_t const length,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(source);
+        auto const first = static_cast<std::uint8_t>(target == LetterCase::Upper ? 'a' : 'A');
+        auto const last = static_cast<std::uint8_t>(target == LetterCase::Upper ? 'z' : 'Z');
+        auto const below_first = Ops::splat(static_cast<std::uint8_t>(first - 1));
+        auto const above_last = Ops::splat(static_cast<std::uint8_t>(last + 1));
+        auto const case_bit = Ops::splat(0x20);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const input = Ops::load(bytes + i);
+            if (not Ops::is_ascii(input)) {
+                break;
+            }
+            // signed comparisons are fine since all bytes are ASCII
+            auto const is_letter =
+                    Ops::bit_and(Ops::greater_than(input, below_first), Ops::greater_than(above_last, input));
+            auto const output = Ops::bit_xor(input, Ops::bit_and(is_letter, case_bit));
+            Ops::store(reinterpret_cast<std::uint8_t*>(destination + i), output);
+        }
+        for (; i < length and bytes[i] < 0x80; ++i) {
+            auto const is_letter = bytes[i] >= first and bytes[i] <= last;
+            destination[i] = static_cast<char>(is_letter ? bytes[i] ^ 0x20 : bytes[i]);
+        }
+        return i;
+    }
+
+    template<typename Ops>
+    [[nodiscard]] AsciiWidth measure_ascii_width(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto const below_printable = Ops::splat(0x1F);
+        auto const delete_character = Ops::splat(0x7F);
+        auto width = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const input = Ops::load(bytes + i);
+            if (not Ops::is_ascii(input)) {
+                break;
+            }
+            // signed comparisons are fine since all bytes are ASCII
+            auto const is_printable =
+                    Ops::bit_and(Ops::greater_than(input, below_printable), Ops::greater_than(delete_character, input));
+            width += Ops::count_high_bits(is_printable);
+        }
+        for (; i < length and bytes[i] < 0x80; ++i) {
+            if (bytes[i] > 0x1F and bytes[i] < 0x7F) {
+                ++width;
+            }
+        }
+        return AsciiWidth{ i, width };
+    }
+
+    // clang-format off
+    template<typename Ops>
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        char const* const lhs,
+        char const* const rhs,
+        std::size_t const length
+    ) { // clang-format on
+        auto const lhs_bytes = reinterpret_cast<std::uint8_t const*>(lhs);
+        auto const rhs_bytes = reinterpret_cast<std::uint8_t const*>(rhs);
+        auto const before_upper = Ops::splat('A' - 1);
+        auto const after_upper = Ops::splat('Z' + 1);
+        auto const case_bit = Ops::splat(0x20);
+        // signed comparisons are fine since the inputs are only folded if they are ASCII
+        auto const to_lowercase = [&](typename Ops::Register const input) {
+            auto const is_upper =
+                    Ops::bit_and(Ops::greater_than(input, before_upper), Ops::greater_than(after_upper, input));
+            return Ops::bit_or(input, Ops::bit_and(is_upper, case_bit));
+        };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const lhs_input = Ops::load(lhs_bytes + i);
+            auto const rhs_input = Ops::load(rhs_bytes + i);
+            if (not Ops::is_ascii(Ops::bit_or(lhs_input, rhs_input))
+                or not Ops::is_zero(Ops::bit_xor(to_lowercase(lhs_input), to_lowercase(rhs_input)))) {
+                break;
+            }
+        }
+        for (; i < length and lhs_bytes[i] < 0x80 and rhs_bytes[i] < 0x80; ++i) {
+            auto const lhs_lower = (lhs_bytes[i] >= 'A' and lhs_bytes[i] <= 'Z') ? lhs_bytes[i] | 0x20 : lhs_bytes[i];
+            auto const rhs_lower = (rhs_bytes[i] >= 'A' and rhs_bytes[i] <= 'Z') ? rhs_bytes[i] | 0x20 : rhs_bytes[i];
+            if (lhs_lower != rhs_lower) {
+                break;
+            }
+        }
+        return i;
+    }
+    template<typename Ops>
+    [[nodiscard]] std::size_t count_utf16_code_units(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        // every char needs one code unit, chars that are encoded with four bytes need two
+        auto const before_four_byte_lead = Ops::splat(0b1110'1111);
+        auto result = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const input = Ops::load(bytes + i);
+            auto const is_four_byte_lead = Ops::bit_and(Ops::greater_than(input, before_four_byte_lead), input);
+            result += Ops::register_size - Ops::count_continuation_bytes(input);
+            result += Ops::count_high_bits(is_four_byte_lead);
+        }
+        for (; i < length; ++i) {
+            if ((bytes[i] & 0b1100'0000) != 0b1000'0000) {
+                ++result;
+            }
+            if (bytes[i] >= 0b1111'0000) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // clang-format off
+    template<typename Ops, typename CodeUnit>
+    [[nodiscard]] std::size_t widen_ascii(
+        char const* const source,
+        std::size_t const length,
+        CodeUnit* const destination
+    ) { // clang-format on
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(source);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const input = Ops::load(bytes + i);
+            if (not Ops::is_ascii(input)) {
+                break;
+            }
+            Ops::store_widened(input, destination + i);
+        }
+        for (; i < length and bytes[i] < 0x80; ++i) {
+            destination[i] = static_cast<CodeUnit>(bytes[i]);
+        }
+        return i;
+    }
+
+    // clang-format off
+    template<typename Ops, typename CodeUnit>
+    [[nodiscard]] std::size_t narrow_ascii(
+        CodeUnit const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto narrowed = Ops::zero();
+            if (not Ops::load_narrowed(source + i, narrowed)) {
+                break;
+            }
+            Ops::store(reinterpret_cast<std::uint8_t*>(destination + i), narrowed);
+        }
+        for (; i < length and source[i] < 0x80; ++i) {
+            destination[i] = static_cast<char>(source[i]);
+        }
+        return i;
+    }
+
+    // Compares the first and the last byte of `needle` at `register_size` positions at once, so that only the
+    // candidates that pass this filter have to be compared completely. Returns `length` if there is no match.
+    // clang-format off
+    template<typename Ops>
+    [[nodiscard]] std::size_t find_substring(
+        char const* const haystack,
+        std::size_t const length,
+        char const* const needle,
+        std::size_t const needle_length
+    ) { // clang-format on
+        if (needle_length == 0) {
+            return 0;
+        }
+        if (needle_length > length) {
+            return length;
+        }
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(haystack);
+        auto const first_byte = static_cast<std::uint8_t>(needle[0]);
+        auto const last_offset = needle_length - 1;
+        auto const last_byte = static_cast<std::uint8_t>(needle[last_offset]);
+        auto const first = Ops::splat(first_byte);
+        auto const last = Ops::splat(last_byte);
+        auto const num_positions = length - last_offset;
+        auto i = std::size_t{ 0 };
+        for (; num_positions - i >= Ops::register_size; i += Ops::register_size) {
+            auto candidates = Ops::equal_mask(Ops::load(bytes + i), first)
+                              & Ops::equal_mask(Ops::load(bytes + i + last_offset), last);
+            while (candidates != 0) {
+                auto const position = i + Ops::lowest_set_bit(candidates);
+                if (std::memcmp(haystack + position + 1, needle + 1, last_offset) == 0) {
+                    return position;
+                }
+                candidates &= candidates - 1;
+            }
+        }
+        for (; i < num_positions; ++i) {
+            if (bytes[i] == first_byte and bytes[i + last_offset] == last_byte
+                and std::memcmp(haystack + i + 1, needle + 1, last_offset) == 0) {
+                return i;
+            }
+        }
+        return length;
+    }
+
+    // Classifies `register_size` bytes at once with two shuffles. Returns `length` if no byte matches.
+    // clang-format off
+    template<typename Ops>
+    [[nodiscard]] std::size_t find_nibble_match(
+        char const* const data,
+        std::size_t const length,
+        NibbleTables const& tables
+    ) { // clang-format on
+        static constexpr auto all_lanes =
+                Ops::register_size == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << Ops::register_size) - 1;
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto const low_table = Ops::table(tables.low);
+        auto const high_table = Ops::table(tables.high);
+        auto const zero = Ops::zero();
+        auto i = std::size_t{ 0 };
+        for (; length - i >= Ops::register_size; i += Ops::register_size) {
+            auto const input = Ops::load(bytes + i);
+            auto const classes = Ops::bit_and(
+                    Ops::lookup(low_table, Ops::low_nibbles(input)),
+                    Ops::lookup(high_table, Ops::high_nibbles(input))
+            );
+            auto const matches = ~Ops::equal_mask(classes, zero) & all_lanes;
+            if (matches != 0) {
+                return i + Ops::lowest_set_bit(matches);
+            }
+        }
+        for (; i < length; ++i) {
+            if ((tables.low[bytes[i] & 0x0F] & tables.high[bytes[i] >> 4]) != 0) {
+                return i;
+            }
+        }
+        return length;
+    }
+} // namespace c2k::detail::simd
@@ -0,0 +1,337 @@
+#include "simd.hpp"
+#include <cstdint>
+#include <cstring>
+
+namespace c2k::detail::simd::scalar {
+    namespace {
+        constexpr auto word_size = sizeof(std::uint64_t);
+        constexpr auto high_bits = std::uint64_t{ 0x8080'8080'8080'8080 };
+        constexpr auto low_bits = std::uint64_t{ 0x0101'0101'0101'0101 };
+
+        [[nodiscard]] std::uint64_t load_word(unsigned char const* const data) {
+            auto word = std::uint64_t{};
+            std::memcpy(&word, data, word_size);
+            return word;
+        }
+
+        [[nodiscard]] bool is_continuation_byte(unsigned char const byte) {
+            return (byte & 0b1100'0000) == 0b1000'0000;
+        }
+
+        [[nodiscard]] bool is_in_range(unsigned char const byte, unsigned char const lower, unsigned char const upper) {
+            return byte >= lower and byte <= upper;
+        }
+    } // namespace
+
+    // see table 3-7 of the Unicode standard (well-formed UTF-8 byte sequences)
+    [[nodiscard]] Utf8ValidationResult validate_utf8(char const* const data, std::size_t const length) {
+        static constexpr auto invalid = Utf8ValidationResult{ false, false };
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        auto all_ascii = true;
+        auto i = std::size_t{ 0 };
+        while (i < length) {
+            if (length - i >= word_size and (load_word(bytes + i) & high_bits) == 0) {
+                i += word_size;
+                continue;
+            }
+            auto const lead = bytes[i];
+            auto const remaining = length - i;
+            if (lead < 0x80) {
+                ++i;
+                continue;
+            }
+            all_ascii = false;
+            if (lead < 0xC2) {
+                return invalid;
+            } else if (lead < 0xE0) {
+                if (remaining < 2 or not is_continuation_byte(bytes[i + 1])) {
+                    return invalid;
+                }
+                i += 2;
+            } else if (lead < 0xF0) {
+                if (remaining < 3) {
+                    return invalid;
+                }
+                auto const lower = static_cast<unsigned char>(lead == 0xE0 ? 0xA0 : 0x80);
+                auto const upper = static_cast<unsigned char>(lead == 0xED ? 0x9F : 0xBF);
+                if (not is_in_range(bytes[i + 1], lower, upper) or not is_continuation_byte(bytes[i + 2])) {
+                    return invalid;
+                }
+                i += 3;
+            } else if (lead < 0xF5) {
+                if (remaining < 4) {
+                    return invalid;
+                }
+                auto const lower = static_cast<unsigned char>(lead == 0xF0 ? 0x90 : 0x80);
+                auto const upper = static_cast<unsigned char>(lead == 0xF4 ? 0x8F : 0xBF);
+                if (not is_in_range(bytes[i + 1], lower, upper) or not is_continuation_byte(bytes[i + 2])
+                    or not is_continuation_byte(bytes[i + 3])) {
+                    return invalid;
+                }
+                i += 4;
+            } else {
+                return invalid;
+            }
+        }
+        return Utf8ValidationResult{ true, all_ascii };
+    }
+
+    [[nodiscard]] bool is_ascii(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            if ((load_word(bytes + i) & high_bits) != 0) {
+                return false;
+            }
+        }
+        for (; i < length; ++i) {
+            if (bytes[i] >= 0x80) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::size_t ascii_prefix_length(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            if ((load_word(bytes + i) & high_bits) != 0) {
+                break;
+            }
+        }
+        while (i < length and bytes[i] < 0x80) {
+            ++i;
+        }
+        return i;
+    }
+
+    [[nodiscard]] std::size_t count_chars(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        auto result = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            // a byte starts a new char unless its high bits are 10
+            auto const word = load_word(bytes + i);
+            auto const starts_char = ((~word >> 7) | (word >> 6)) & low_bits;
+            // sums up all bytes of `starts_char` in the most significant byte
+            result += static_cast<std::size_t>((starts_char * low_bits) >> 56);
+        }
+        for (; i < length; ++i) {
+            if (not is_continuation_byte(bytes[i])) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t convert_ascii_case(
+        char const* const source,
+        std::size_t const length,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        auto const bytes = reinterpret_cast<unsigned char const*>(source);
+        auto const first = static_cast<unsigned char>(target == LetterCase::Upper ? 'a' : 'A');
+        auto const last = static_cast<unsigned char>(target == LetterCase::Upper ? 'z' : 'Z');
+        // adding these sets the high bit of every byte that is >= first (or > last, respectively)
+        auto const at_least_first = low_bits * (0x80U - first);
+        auto const above_last = low_bits * (0x7FU - last);
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            auto const word = load_word(bytes + i);
+            if ((word & high_bits) != 0) {
+                break;
+            }
+            // since all bytes are ASCII, the additions cannot carry into the next byte
+            auto const is_letter = ((word + at_least_first) ^ (word + above_last)) & high_bits;
+            auto const output = word ^ (is_letter >> 2);
+            std::memcpy(destination + i, &output, word_size);
+        }
+        for (; i < length and bytes[i] < 0x80; ++i) {
+            auto const is_letter = bytes[i] >= first and bytes[i] <= last;
+            destination[i] = static_cast<char>(is_letter ? bytes[i] ^ 0x20 : bytes[i]);
+        }
+        return i;
+    }
+
+    [[nodiscard]] AsciiWidth measure_ascii_width(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        // adding these sets the high bit of every byte that is > 0x1F (or >= 0x7F, respectively)
+        static constexpr auto above_control = low_bits * (0x80U - 0x20U);
+        static constexpr auto at_least_delete = low_bits * (0x80U - 0x7FU);
+        auto width = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            auto const word = load_word(bytes + i);
+            if ((word & high_bits) != 0) {
+                break;
+            }
+            // since all bytes are ASCII, the additions cannot carry into the next byte
+            auto const is_printable = ((word + above_control) & ~(word + at_least_delete)) & high_bits;
+            width += static_cast<std::size_t>(((is_printable >> 7) * low_bits) >> 56);
+        }
+        for (; i < length and bytes[i] < 0x80; ++i) {
+            if (bytes[i] > 0x1F and bytes[i] < 0x7F) {
+                ++width;
+            }
+        }
+        return AsciiWidth{ i, width };
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        char const* const lhs,
+        char const* const rhs,
+        std::size_t const length
+    ) { // clang-format on
+        auto const lhs_bytes = reinterpret_cast<unsigned char const*>(lhs);
+        auto const rhs_bytes = reinterpret_cast<unsigned char const*>(rhs);
+        // see convert_ascii_case()
+        static constexpr auto at_least_first = low_bits * (0x80U - 'A');
+        static constexpr auto above_last = low_bits * (0x7FU - 'Z');
+        auto const to_lowercase = [](std::uint64_t const word) {
+            return word | ((((word + at_least_first) ^ (word + above_last)) & high_bits) >> 2);
+        };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            auto const lhs_word = load_word(lhs_bytes + i);
+            auto const rhs_word = load_word(rhs_bytes + i);
+            if (((lhs_word | rhs_word) & high_bits) != 0 or to_lowercase(lhs_word) != to_lowercase(rhs_word)) {
+                break;
+            }
+        }
+        for (; i < length and lhs_bytes[i] < 0x80 and rhs_bytes[i] < 0x80; ++i) {
+            auto const lhs_lower = (lhs_bytes[i] >= 'A' and lhs_bytes[i] <= 'Z') ? lhs_bytes[i] | 0x20 : lhs_bytes[i];
+            auto const rhs_lower = (rhs_bytes[i] >= 'A' and rhs_bytes[i] <= 'Z') ? rhs_bytes[i] | 0x20 : rhs_bytes[i];
+            if (lhs_lower != rhs_lower) {
+                break;
+            }
+        }
+        return i;
+    }
+
+    [[nodiscard]] std::size_t count_utf16_code_units(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<unsigned char const*>(data);
+        auto result = std::size_t{ 0 };
+        auto i = std::size_t{ 0 };
+        for (; length - i >= word_size; i += word_size) {
+            // every char needs one code unit (see count_chars()), chars that are encoded with four bytes need two
+            auto const word = load_word(bytes + i);
+            auto const starts_char = ((~word >> 7) | (word >> 6)) & low_bits;
+            auto const is_four_byte_lead = (word & (word << 1) & (word << 2) & (word << 3) & high_bits) >> 7;
+            result += static_cast<std::size_t>(((starts_char + is_four_byte_lead) * low_bits) >> 56);
+        }
+        for (; i < length; ++i) {
+            if (not is_continuation_byte(bytes[i])) {
+                ++result;
+            }
+            if (bytes[i] >= 0b1111'0000) {
+                ++result;
+            }
+        }
+        return result;
+    }
+
+    namespace {
+        // clang-format off
+        template<typename CodeUnit>
+        [[nodiscard]] std::size_t widen_ascii(
+            char const* const source,
+            std::size_t const length,
+            CodeUnit* const destination
+        ) { // clang-format on
+            auto const bytes = reinterpret_cast<unsigned char const*>(source);
+            auto i = std::size_t{ 0 };
+            for (; length - i >= word_size; i += word_size) {
+                if ((load_word(bytes + i) & high_bits) != 0) {
+                    break;
+                }
+                for (auto offset = std::size_t{ 0 }; offset < word_size; ++offset) {
+                    destination[i + offset] = static_cast<CodeUnit>(bytes[i + offset]);
+                }
+            }
+            for (; i < length and bytes[i] < 0x80; ++i) {
+                destination[i] = static_cast<CodeUnit>(bytes[i]);
+            }
+            return i;
+        }
+
+        // clang-format off
+        template<typename CodeUnit>
+        [[nodiscard]] std::size_t narrow_ascii(
+            CodeUnit const* const source,
+            std::size_t const length,
+            char* const destination
+        ) { // clang-format on
+            auto i = std::size_t{ 0 };
+            for (; i < length and source[i] < 0x80; ++i) {
+                destination[i] = static_cast<char>(source[i]);
+            }
+            return i;
+        }
+    } // namespace
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf16(
+        char const* const source,
+        std::size_t const length,
+        char16_t* const destination
+    ) { // clang-format on
+        return widen_ascii(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf32(
+        char const* const source,
+        std::size_t const length,
+        char32_t* const destination
+    ) { // clang-format on
+        return widen_ascii(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+        char16_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return narrow_ascii(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+        char32_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return narrow_ascii(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_substring(
+        char const* const haystack,
+        std::size_t const length,
+        char const* const needle,
+        std::size_t const needle_length
+    ) { // clang-format on
+        auto const position = std::string_view{ haystack, length }.find(std::string_view{ needle, needle_length });
+        return position == std::string_view::npos ? length : position;
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_nibble_match(
+        char const* const data,
+        std::size_t const length,
+        NibbleTables const& tables
+    ) { // clang-format on
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        for (auto i = std::size_t{ 0 }; i < length; ++i) {
+            if ((tables.low[bytes[i] & 0x0F] & tables.high[bytes[i] >> 4]) != 0) {
+                return i;
+            }
+        }
+        return length;
+    }
+} // namespace c2k::detail::simd::scalar
@@ -0,0 +1,273 @@
+#pragma once
+
+// This header is included by the translation units that are compiled with instruction set extensions
+// enabled (see src/CMakeLists.txt). It must therefore only contain declarations. Everything that
+// actually generates code belongs into the respective translation unit.
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace c2k::detail::simd {
+    enum class InstructionSet {
+        Scalar,
+        Sse4,
+        Avx2,
+        Avx512,
+    };
+
+    struct Utf8ValidationResult final {
+        bool is_valid;
+        bool is_ascii;
+    };
+
+    enum class LetterCase {
+        Upper,
+        Lower,
+    };
+
+    struct AsciiWidth final {
+        std::size_t num_bytes;
+        std::size_t width;
+    };
+
+    // Classifies bytes with two table lookups (by the low and the high nibble of each byte). A byte is a match
+    // if `low[byte & 0x0F] & high[byte >> 4]` is not zero.
+    struct NibbleTables final {
+        std::uint8_t low[16];
+        std::uint8_t high[16];
+    };
+
+    // The kernels of one instruction set. See the dispatching functions below for what they do. Unlike those, the
+    // searching kernels return `length` (instead of std::string_view::npos) if there is no match.
+    struct Kernels final {
+        InstructionSet instruction_set;
+        Utf8ValidationResult (*validate_utf8)(char const* data, std::size_t length);
+        bool (*is_ascii)(char const* data, std::size_t length);
+        std::size_t (*ascii_prefix_length)(char const* data, std::size_t length);
+        std::size_t (*count_chars)(char const* data, std::size_t length);
+        std::size_t (*convert_ascii_case)(char const* source, std::size_t length, char* destination, LetterCase target);
+        AsciiWidth (*measure_ascii_width)(char const* data, std::size_t length);
+        std::size_t (*ascii_common_prefix_ignore_case)(char const* lhs, char const* rhs, std::size_t length);
+        std::size_t (*count_utf16_code_units)(char const* data, std::size_t length);
+        std::size_t (*widen_ascii_to_utf16)(char const* source, std::size_t length, char16_t* destination);
+        std::size_t (*widen_ascii_to_utf32)(char const* source, std::size_t length, char32_t* destination);
+        std::size_t (*narrow_ascii_from_utf16)(char16_t const* source, std::size_t length, char* destination);
+        std::size_t (*narrow_ascii_from_utf32)(char32_t const* source, std::size_t length, char* destination);
+        // clang-format off
+        std::size_t (*find_substring)(
+            char const* haystack,
+            std::size_t length,
+            char const* needle,
+            std::size_t needle_length
+        ); // clang-format on
+        std::size_t (*find_nibble_match)(char const* data, std::size_t length, NibbleTables const& tables);
+    };
+
+    // Returns the most capable instruction set that is supported by both the current CPU and
+    // the build configuration of lib2k. The result is determined once and then cached.
+    [[nodiscard]] InstructionSet active_instruction_set();
+
+    // Returns the kernels of `instruction_set`, which must not be more capable than active_instruction_set(). The
+    // library itself only uses the kernels of the active instruction set (through the functions below), but the
+    // tests run every kernel that the current CPU supports.
+    [[nodiscard]] Kernels kernels_for(InstructionSet instruction_set);
+
+    [[nodiscard]] Utf8ValidationResult validate_utf8(std::string_view string);
+    [[nodiscard]] bool is_ascii(std::string_view string);
+    // Returns the length of the longest ASCII-only prefix of `string`.
+    [[nodiscard]] std::size_t ascii_prefix_length(std::string_view string);
+    // The input must be valid UTF-8. The result is the number of bytes that are not continuation bytes.
+    [[nodiscard]] std::size_t count_chars(std::string_view string);
+    // Converts the longest ASCII-only prefix of `source` into the target case and writes it to `destination`.
+    // Returns the length of that prefix.
+    [[nodiscard]] std::size_t convert_ascii_case(std::string_view source, char* destination, LetterCase target);
+    // Measures the longest ASCII-only prefix of `string`. Printable characters have a width of 1, control
+    // characters have a width of 0.
+    [[nodiscard]] AsciiWidth measure_ascii_width(std::string_view string);
+    // Returns the length of the longest common prefix of `lhs` and `rhs` that only consists of ASCII characters
+    // and ignores the case of letters.
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(std::string_view lhs, std::string_view rhs);
+    // The input must be valid UTF-8. Returns the number of UTF-16 code units needed to represent it.
+    [[nodiscard]] std::size_t count_utf16_code_units(std::string_view string);
+    // The widening and narrowing kernels copy the longest ASCII-only prefix of `source` into `destination`
+    // (converting each code unit) and return the length of that prefix.
+    [[nodiscard]] std::size_t widen_ascii(std::string_view source, char16_t* destination);
+    [[nodiscard]] std::size_t widen_ascii(std::string_view source, char32_t* destination);
+    [[nodiscard]] std::size_t narrow_ascii(std::u16string_view source, char* destination);
+    [[nodiscard]] std::size_t narrow_ascii(std::u32string_view source, char* destination);
+    // Returns the position of the first occurrence of `needle` in `haystack` or std::string_view::npos.
+    [[nodiscard]] std::size_t find_substring(std::string_view haystack, std::string_view needle);
+    // Returns the position of the first byte of `string` that matches `tables` or std::string_view::npos.
+    [[nodiscard]] std::size_t find_nibble_match(std::string_view string, NibbleTables const& tables);
+
+    namespace scalar {
+        [[nodiscard]] Utf8ValidationResult validate_utf8(char const* data, std::size_t length);
+        [[nodiscard]] bool is_ascii(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t ascii_prefix_length(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t count_chars(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t convert_ascii_case(
+            char const* source,
+            std::size_t length,
+            char* destination,
+            LetterCase target
+        ); // clang-format on
+        [[nodiscard]] AsciiWidth measure_ascii_width(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+            char const* lhs,
+            char const* rhs,
+            std::size_t length
+        ); // clang-format on
+        [[nodiscard]] std::size_t count_utf16_code_units(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t widen_ascii_to_utf16(char const* source, std::size_t length, char16_t* destination);
+        [[nodiscard]] std::size_t widen_ascii_to_utf32(char const* source, std::size_t length, char32_t* destination);
+        // clang-format off
+        [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+            char16_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+            char32_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t find_substring(
+            char const* haystack,
+            std::size_t length,
+            char const* needle,
+            std::size_t needle_length
+        ); // clang-format on
+        [[nodiscard]] std::size_t find_nibble_match(char const* data, std::size_t length, NibbleTables const& tables);
+    } // namespace scalar
+
+#ifdef LIB2K_SIMD_X86
+    namespace sse4 {
+        [[nodiscard]] Utf8ValidationResult validate_utf8(char const* data, std::size_t length);
+        [[nodiscard]] bool is_ascii(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t ascii_prefix_length(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t count_chars(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t convert_ascii_case(
+            char const* source,
+            std::size_t length,
+            char* destination,
+            LetterCase target
+        ); // clang-format on
+        [[nodiscard]] AsciiWidth measure_ascii_width(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+            char const* lhs,
+            char const* rhs,
+            std::size_t length
+        ); // clang-format on
+        [[nodiscard]] std::size_t count_utf16_code_units(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t widen_ascii_to_utf16(char const* source, std::size_t length, char16_t* destination);
+        [[nodiscard]] std::size_t widen_ascii_to_utf32(char const* source, std::size_t length, char32_t* destination);
+        // clang-format off
+        [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+            char16_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+            char32_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t find_substring(
+            char const* haystack,
+            std::size_t length,
+            char const* needle,
+            std::size_t needle_length
+        ); // clang-format on
+        [[nodiscard]] std::size_t find_nibble_match(char const* data, std::size_t length, NibbleTables const& tables);
+    } // namespace sse4
+
+    namespace avx2 {
+        [[nodiscard]] Utf8ValidationResult validate_utf8(char const* data, std::size_t length);
+        [[nodiscard]] bool is_ascii(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t ascii_prefix_length(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t count_chars(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t convert_ascii_case(
+            char const* source,
+            std::size_t length,
+            char* destination,
+            LetterCase target
+        ); // clang-format on
+        [[nodiscard]] AsciiWidth measure_ascii_width(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+            char const* lhs,
+            char const* rhs,
+            std::size_t length
+        ); // clang-format on
+        [[nodiscard]] std::size_t count_utf16_code_units(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t widen_ascii_to_utf16(char const* source, std::size_t length, char16_t* destination);
+        [[nodiscard]] std::size_t widen_ascii_to_utf32(char const* source, std::size_t length, char32_t* destination);
+        // clang-format off
+        [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+            char16_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+            char32_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t find_substring(
+            char const* haystack,
+            std::size_t length,
+            char const* needle,
+            std::size_t needle_length
+        ); // clang-format on
+        [[nodiscard]] std::size_t find_nibble_match(char const* data, std::size_t length, NibbleTables const& tables);
+    } // namespace avx2
+
+    namespace avx512 {
+        [[nodiscard]] Utf8ValidationResult validate_utf8(char const* data, std::size_t length);
+        [[nodiscard]] bool is_ascii(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t ascii_prefix_length(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t count_chars(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t convert_ascii_case(
+            char const* source,
+            std::size_t length,
+            char* destination,
+            LetterCase target
+        ); // clang-format on
+        [[nodiscard]] AsciiWidth measure_ascii_width(char const* data, std::size_t length);
+        // clang-format off
+        [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+            char const* lhs,
+            char const* rhs,
+            std::size_t length
+        ); // clang-format on
+        [[nodiscard]] std::size_t count_utf16_code_units(char const* data, std::size_t length);
+        [[nodiscard]] std::size_t widen_ascii_to_utf16(char const* source, std::size_t length, char16_t* destination);
+        [[nodiscard]] std::size_t widen_ascii_to_utf32(char const* source, std::size_t length, char32_t* destination);
+        // clang-format off
+        [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+            char16_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+            char32_t const* source,
+            std::size_t length,
+            char* destination
+        );
+        [[nodiscard]] std::size_t find_substring(
+            char const* haystack,
+            std::size_t length,
+            char const* needle,
+            std::size_t needle_length
+        ); // clang-format on
+        [[nodiscard]] std::size_t find_nibble_match(char const* data, std::size_t length, NibbleTables const& tables);
+    } // namespace avx512
+#endif
+} // namespace c2k::detail::simd
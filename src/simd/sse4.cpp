@@ -0,0 +1,239 @@
+#include "generic_kernels.hpp"
+#include "simd.hpp"
+#include "utf8_validation.hpp"
+#include <immintrin.h>
+
+namespace c2k::detail::simd::sse4 {
+    namespace {
+        struct Ops final {
+            using Register = __m128i;
+            static constexpr auto register_size = sizeof(Register);
+
+            [[nodiscard]] static Register zero() {
+                return _mm_setzero_si128();
+            }
+
+            [[nodiscard]] static Register splat(std::uint8_t const value) {
+                return _mm_set1_epi8(static_cast<char>(value));
+            }
+
+            [[nodiscard]] static Register load(std::uint8_t const* const data) {
+                return _mm_loadu_si128(reinterpret_cast<__m128i const*>(data));
+            }
+
+            static void store(std::uint8_t* const data, Register const value) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value);
+            }
+
+            // signed comparison
+            [[nodiscard]] static Register greater_than(Register const lhs, Register const rhs) {
+                return _mm_cmpgt_epi8(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register table(std::uint8_t const (&values)[16]) {
+                return load(values);
+            }
+
+            [[nodiscard]] static Register lookup(Register const table, Register const indices) {
+                return _mm_shuffle_epi8(table, indices);
+            }
+
+            [[nodiscard]] static Register high_nibbles(Register const value) {
+                return _mm_and_si128(_mm_srli_epi16(value, 4), splat(0x0F));
+            }
+
+            [[nodiscard]] static Register low_nibbles(Register const value) {
+                return _mm_and_si128(value, splat(0x0F));
+            }
+
+            [[nodiscard]] static Register bit_and(Register const lhs, Register const rhs) {
+                return _mm_and_si128(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_or(Register const lhs, Register const rhs) {
+                return _mm_or_si128(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register bit_xor(Register const lhs, Register const rhs) {
+                return _mm_xor_si128(lhs, rhs);
+            }
+
+            [[nodiscard]] static Register saturating_sub(Register const lhs, Register const rhs) {
+                return _mm_subs_epu8(lhs, rhs);
+            }
+
+            // shifts in the last `N` bytes of `previous_input`
+            template<int N>
+            [[nodiscard]] static Register previous(Register const input, Register const previous_input) {
+                return _mm_alignr_epi8(input, previous_input, 16 - N);
+            }
+
+            [[nodiscard]] static bool is_ascii(Register const value) {
+                return _mm_movemask_epi8(value) == 0;
+            }
+
+            [[nodiscard]] static bool is_zero(Register const value) {
+                return _mm_testz_si128(value, value) != 0;
+            }
+
+            [[nodiscard]] static std::size_t count_high_bits(Register const value) {
+                return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned int>(_mm_movemask_epi8(value))));
+            }
+
+            // The widening and narrowing operations process `register_size` code units at once.
+            static void store_widened(Register const value, char16_t* const destination) {
+                auto const output = reinterpret_cast<__m128i*>(destination);
+                _mm_storeu_si128(output, _mm_cvtepu8_epi16(value));
+                _mm_storeu_si128(output + 1, _mm_cvtepu8_epi16(_mm_srli_si128(value, 8)));
+            }
+
+            static void store_widened(Register const value, char32_t* const destination) {
+                auto const output = reinterpret_cast<__m128i*>(destination);
+                _mm_storeu_si128(output, _mm_cvtepu8_epi32(value));
+                _mm_storeu_si128(output + 1, _mm_cvtepu8_epi32(_mm_srli_si128(value, 4)));
+                _mm_storeu_si128(output + 2, _mm_cvtepu8_epi32(_mm_srli_si128(value, 8)));
+                _mm_storeu_si128(output + 3, _mm_cvtepu8_epi32(_mm_srli_si128(value, 12)));
+            }
+
+            // returns false (and leaves `result` untouched) if not all code units are ASCII
+            [[nodiscard]] static bool load_narrowed(char16_t const* const source, Register& result) {
+                auto const input = reinterpret_cast<__m128i const*>(source);
+                auto const low = _mm_loadu_si128(input);
+                auto const high = _mm_loadu_si128(input + 1);
+                if (_mm_testz_si128(_mm_or_si128(low, high), _mm_set1_epi16(static_cast<short>(0xFF80))) == 0) {
+                    return false;
+                }
+                result = _mm_packus_epi16(low, high);
+                return true;
+            }
+
+            [[nodiscard]] static bool load_narrowed(char32_t const* const source, Register& result) {
+                auto const input = reinterpret_cast<__m128i const*>(source);
+                auto const first = _mm_loadu_si128(input);
+                auto const second = _mm_loadu_si128(input + 1);
+                auto const third = _mm_loadu_si128(input + 2);
+                auto const fourth = _mm_loadu_si128(input + 3);
+                auto const combined = _mm_or_si128(_mm_or_si128(first, second), _mm_or_si128(third, fourth));
+                if (_mm_testz_si128(combined, _mm_set1_epi32(static_cast<int>(0xFFFF'FF80))) == 0) {
+                    return false;
+                }
+                result = _mm_packus_epi16(_mm_packus_epi32(first, second), _mm_packus_epi32(third, fourth));
+                return true;
+            }
+
+            // continuation bytes are the only bytes that are less than 0b1100'0000 when interpreted as signed values
+            [[nodiscard]] static std::size_t count_continuation_bytes(Register const value) {
+                auto const mask = _mm_movemask_epi8(_mm_cmpgt_epi8(splat(0b1100'0000), value));
+                return static_cast<std::size_t>(_mm_popcnt_u32(static_cast<unsigned int>(mask)));
+            }
+
+            [[nodiscard]] static std::uint64_t equal_mask(Register const lhs, Register const rhs) {
+                auto const mask = _mm_movemask_epi8(_mm_cmpeq_epi8(lhs, rhs));
+                return static_cast<std::uint64_t>(static_cast<unsigned int>(mask));
+            }
+
+            // the number of trailing zeros (`mask` must not be zero)
+            [[nodiscard]] static std::size_t lowest_set_bit(std::uint64_t const mask) {
+                return static_cast<std::size_t>(_mm_popcnt_u64((mask - 1) & ~mask));
+            }
+        };
+    } // namespace
+
+    [[nodiscard]] Utf8ValidationResult validate_utf8(char const* const data, std::size_t const length) {
+        return simd::validate_utf8<Ops>(data, length);
+    }
+
+    [[nodiscard]] bool is_ascii(char const* const data, std::size_t const length) {
+        return simd::is_ascii<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t ascii_prefix_length(char const* const data, std::size_t const length) {
+        return simd::ascii_prefix_length<Ops>(data, length);
+    }
+
+    [[nodiscard]] std::size_t count_chars(char const* const data, std::size_t const length) {
+        return simd::count_chars<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t convert_ascii_case(
+        char const* const source,
+        std::size_t const length,
+        char* const destination,
+        LetterCase const target
+    ) { // clang-format on
+        return simd::convert_ascii_case<Ops>(source, length, destination, target);
+    }
+
+    [[nodiscard]] AsciiWidth measure_ascii_width(char const* const data, std::size_t const length) {
+        return simd::measure_ascii_width<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t ascii_common_prefix_ignore_case(
+        char const* const lhs,
+        char const* const rhs,
+        std::size_t const length
+    ) { // clang-format on
+        return simd::ascii_common_prefix_ignore_case<Ops>(lhs, rhs, length);
+    }
+
+    [[nodiscard]] std::size_t count_utf16_code_units(char const* const data, std::size_t const length) {
+        return simd::count_utf16_code_units<Ops>(data, length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf16(
+        char const* const source,
+        std::size_t const length,
+        char16_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t widen_ascii_to_utf32(
+        char const* const source,
+        std::size_t const length,
+        char32_t* const destination
+    ) { // clang-format on
+        return simd::widen_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf16(
+        char16_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t narrow_ascii_from_utf32(
+        char32_t const* const source,
+        std::size_t const length,
+        char* const destination
+    ) { // clang-format on
+        return simd::narrow_ascii<Ops>(source, length, destination);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_substring(
+        char const* const haystack,
+        std::size_t const length,
+        char const* const needle,
+        std::size_t const needle_length
+    ) { // clang-format on
+        return simd::find_substring<Ops>(haystack, length, needle, needle_length);
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t find_nibble_match(
+        char const* const data,
+        std::size_t const length,
+        NibbleTables const& tables
+    ) { // clang-format on
+        return simd::find_nibble_match<Ops>(data, length, tables);
+    }
+} // namespace c2k::detail::simd::sse4
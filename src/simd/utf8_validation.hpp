@@ -0,0 +1,194 @@
+#pragma once
+
+// Vectorized UTF-8 validation based on the "lookup" algorithm described in
+//     John Keiser, Daniel Lemire: Validating UTF-8 In Less Than One Instruction Per Byte (2021)
+//     https://arxiv.org/abs/2010.03090
+//
+// The algorithm is written once and instantiated per instruction set. `Ops` provides the register type and
+// the primitive operations for the respective instruction set. Since `Ops` is always declared inside of an
+// unnamed namespace, every instantiation is local to the translation unit that was compiled with the
+// matching compiler flags.
+
+#include "simd.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace c2k::detail::simd {
+    inline constexpr auto block_size = std::size_t{ 64 };
+
+    namespace utf8_validation {
+        // clang-format off
+        inline constexpr auto too_short      = std::uint8_t{ 1 << 0 }; // 11______ 0_______ or 11______ 11______
+        inline constexpr auto too_long       = std::uint8_t{ 1 << 1 }; // 0_______ 10______
+        inline constexpr auto overlong_3     = std::uint8_t{ 1 << 2 }; // 11100000 100_____
+        inline constexpr auto too_large      = std::uint8_t{ 1 << 3 }; // 11110100 1001____ and above
+        inline constexpr auto surrogate      = std::uint8_t{ 1 << 4 }; // 11101101 101_____
+        inline constexpr auto overlong_2     = std::uint8_t{ 1 << 5 }; // 1100000_ 10______
+        inline constexpr auto too_large_1000 = std::uint8_t{ 1 << 6 }; // 11110101 1000____ and above
+        inline constexpr auto overlong_4     = std::uint8_t{ 1 << 6 }; // 11110000 1000____
+        inline constexpr auto two_conts      = std::uint8_t{ 1 << 7 }; // 10______ 10______
+        inline constexpr auto carry          = std::uint8_t{ too_short | too_long | two_conts };
+
+        inline constexpr std::uint8_t byte_1_high[16] = {
+            // 0_______ ________ <ASCII in byte 1>
+            too_long, too_long, too_long, too_long, too_long, too_long, too_long, too_long,
+            // 10______ ________ <continuation in byte 1>
+            two_conts, two_conts, two_conts, two_conts,
+            // 1100____ ________ <two byte lead in byte 1>
+            too_short | overlong_2,
+            // 1101____ ________ <two byte lead in byte 1>
+            too_short,
+            // 1110____ ________ <three byte lead in byte 1>
+            too_short | overlong_3 | surrogate,
+            // 1111____ ________ <four+ byte lead in byte 1>
+            too_short | too_large | too_large_1000 | overlong_4,
+        };
+
+        inline constexpr std::uint8_t byte_1_low[16] = {
+            // ____0000 ________
+            carry | overlong_3 | overlong_2 | overlong_4,
+            // ____0001 ________
+            carry | overlong_2,
+            // ____001_ ________
+            carry,
+            carry,
+            // ____0100 ________
+            carry | too_large,
+            // ____0101 ________
+            carry | too_large | too_large_1000,
+            // ____011_ ________
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            // ____1___ ________
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            // ____1101 ________
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+        };
+
+        inline constexpr std::uint8_t byte_2_high[16] = {
+            // ________ 0_______ <ASCII in byte 2>
+            too_short, too_short, too_short, too_short, too_short, too_short, too_short, too_short,
+            // ________ 1000____
+            too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4,
+            // ________ 1001____
+            too_long | overlong_2 | two_conts | overlong_3 | too_large,
+            // ________ 101_____
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            too_long | overlong_2 | two_conts | surrogate | too_large,
+            // ________ 11______ <lead byte in byte 2>
+            too_short, too_short, too_short, too_short,
+        };
+        // clang-format on
+
+        // The last three bytes of a block must not start a multibyte sequence that does not fit into the block.
+        // Only the last `register_size` bytes of this array are used.
+        inline constexpr std::uint8_t max_values_at_end[block_size] = {
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0b1110'1111, 0b1101'1111,
+            0b1011'1111,
+        };
+    } // namespace utf8_validation
+
+    template<typename Ops>
+    class Utf8Validator final {
+    private:
+        using Register = typename Ops::Register;
+        static constexpr auto registers_per_block = block_size / Ops::register_size;
+        static_assert(registers_per_block * Ops::register_size == block_size);
+
+        Register m_error = Ops::zero();
+        Register m_previous_input = Ops::zero();
+        Register m_previous_incomplete = Ops::zero();
+        bool m_is_ascii = true;
+
+    public:
+        void process_block(std::uint8_t const* const block) {
+            Register input[registers_per_block];
+            auto combined = Ops::zero();
+            for (auto i = std::size_t{ 0 }; i < registers_per_block; ++i) {
+                input[i] = Ops::load(block + i * Ops::register_size);
+                combined = Ops::bit_or(combined, input[i]);
+            }
+            if (Ops::is_ascii(combined)) {
+                // an ASCII block is only invalid if it follows an incomplete multibyte sequence
+                m_error = Ops::bit_or(m_error, m_previous_incomplete);
+                m_previous_input = input[registers_per_block - 1];
+                m_previous_incomplete = Ops::zero();
+                return;
+            }
+            m_is_ascii = false;
+            for (auto i = std::size_t{ 0 }; i < registers_per_block; ++i) {
+                m_error = Ops::bit_or(m_error, check_register(input[i], i == 0 ? m_previous_input : input[i - 1]));
+            }
+            m_previous_input = input[registers_per_block - 1];
+            m_previous_incomplete = Ops::saturating_sub(
+                    m_previous_input,
+                    Ops::load(utf8_validation::max_values_at_end + block_size - Ops::register_size)
+            );
+        }
+
+        void process_remainder(std::uint8_t const* const data, std::size_t const length) {
+            if (length == 0) {
+                return;
+            }
+            // the padding bytes are ASCII, so they only produce an error if they follow an incomplete sequence
+            std::uint8_t buffer[block_size] = {};
+            std::memcpy(buffer, data, length);
+            process_block(buffer);
+        }
+
+        [[nodiscard]] bool has_error() const {
+            return not Ops::is_zero(Ops::bit_or(m_error, m_previous_incomplete));
+        }
+
+        [[nodiscard]] bool is_ascii() const {
+            return m_is_ascii;
+        }
+
+    private:
+        [[nodiscard]] static Register check_register(Register const input, Register const previous_input) {
+            using namespace utf8_validation;
+            auto const previous_1 = Ops::template previous<1>(input, previous_input);
+            auto const special_cases = Ops::bit_and(
+                    Ops::bit_and(
+                            Ops::lookup(Ops::table(byte_1_high), Ops::high_nibbles(previous_1)),
+                            Ops::lookup(Ops::table(byte_1_low), Ops::low_nibbles(previous_1))
+                    ),
+                    Ops::lookup(Ops::table(byte_2_high), Ops::high_nibbles(input))
+            );
+
+            // only 111_____ and 1111____ will be >= 0x80 after the subtraction
+            auto const previous_2 = Ops::template previous<2>(input, previous_input);
+            auto const previous_3 = Ops::template previous<3>(input, previous_input);
+            auto const is_third_byte = Ops::saturating_sub(previous_2, Ops::splat(0b1110'0000 - 0x80));
+            auto const is_fourth_byte = Ops::saturating_sub(previous_3, Ops::splat(0b1111'0000 - 0x80));
+            auto const must_be_continuation = Ops::bit_and(Ops::bit_or(is_third_byte, is_fourth_byte), Ops::splat(0x80));
+
+            return Ops::bit_xor(must_be_continuation, special_cases);
+        }
+    };
+
+    template<typename Ops>
+    [[nodiscard]] Utf8ValidationResult validate_utf8(char const* const data, std::size_t const length) {
+        auto const bytes = reinterpret_cast<std::uint8_t const*>(data);
+        auto validator = Utf8Validator<Ops>{};
+        auto const num_full_blocks = length / block_size;
+        for (auto i = std::size_t{ 0 }; i < num_full_blocks; ++i) {
+            validator.process_block(bytes + i * block_size);
+        }
+        validator.process_remainder(bytes + num_full_blocks * block_size, length % block_size);
+        if (validator.has_error()) {
+            return Utf8ValidationResult{ false, false };
+        }
+        return Utf8ValidationResult{ true, validator.is_ascii() };
+    }
+} // namespace c2k::detail::simd
@@ -1,31 +1,59 @@
+#include "simd/simd.hpp"
+#include <algorithm>
 #include <lib2k/string_utils.hpp>
 
 namespace c2k {
     [[nodiscard]] std::vector<std::string> split(std::string const& s, std::string_view const delimiter) {
-        if (delimiter.empty()) {
-            throw std::invalid_argument{ "cannot split string with empty delimiter" };
-        }
-
-        auto pos = s.find(delimiter);
-        if (pos == std::string::npos) {
-            return { s };
-        }
-
         auto result = std::vector<std::string>{};
-        decltype(pos) last_pos = 0;
-        while (pos != std::string::npos) {
-            result.push_back(s.substr(last_pos, pos - last_pos));
-            last_pos = pos + delimiter.length();
-            pos = s.find(delimiter, last_pos);
+        split_into(s, delimiter, result);
+        return result;
+    }
+
+    void split_into(std::string_view const s, std::string_view const delimiter, std::vector<std::string_view>& result) {
+        auto const parts = split_view(s, delimiter);
+        result.clear();
+        for (auto const part : parts) {
+            result.push_back(part);
         }
+    }
 
-        if (last_pos <= s.length()) {
-            result.push_back(s.substr(last_pos));
+    void split_into(std::string_view const s, std::string_view const delimiter, std::vector<std::string>& result) {
+        auto num_parts = std::size_t{ 0 };
+        for (auto const part : split_view(s, delimiter)) {
+            if (num_parts < result.size()) {
+                result[num_parts].assign(part);
+            } else {
+                result.emplace_back(part);
+            }
+            ++num_parts;
         }
+        result.resize(num_parts);
+    }
 
-        return result;
+    void tokenize_into(std::string_view const s, ByteSet const& delimiters, std::vector<TokenSpan>& result) {
+        tokenize(s, delimiters).spans_into(result);
     }
 
+    namespace detail {
+        [[nodiscard]] std::size_t find_first_in_set(std::string_view const s, std::size_t start, ByteSet const& set) {
+            auto tables = simd::NibbleTables{};
+            std::ranges::copy(set.low_nibble_table(), tables.low);
+            std::ranges::copy(set.high_nibble_table(), tables.high);
+            while (start < s.size()) {
+                auto const candidate = simd::find_nibble_match(s.substr(start), tables);
+                if (candidate == std::string_view::npos) {
+                    return std::string_view::npos;
+                }
+                // only sets that contain non-ASCII bytes can produce false positives
+                if (set.contains(s[start + candidate])) {
+                    return start + candidate;
+                }
+                start += candidate + 1;
+            }
+            return std::string_view::npos;
+        }
+    } // namespace detail
+
     [[nodiscard]] std::string replace(
             std::string original,
             std::string_view const to_replace,
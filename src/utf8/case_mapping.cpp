@@ -0,0 +1,290 @@
+#include "case_mapping.hpp"
+#include "codepoint_table.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <lib2k/utf8/ranges.hpp>
+#include <optional>
+#include <utf8proc.h>
+
+namespace c2k::detail {
+    namespace {
+        // Maps every code point to the difference between its case-mapped code point and itself.
+        using CaseMappingTable = CodepointTable<std::int32_t>;
+
+        [[nodiscard]] CaseMappingTable const& case_mapping_table(simd::LetterCase const target) {
+            if (target == simd::LetterCase::Upper) {
+                static auto const uppercase = CaseMappingTable{ [](char32_t const codepoint) {
+                    auto const value = static_cast<utf8proc_int32_t>(codepoint);
+                    return utf8proc_toupper(value) - value;
+                } };
+                return uppercase;
+            }
+            static auto const lowercase = CaseMappingTable{ [](char32_t const codepoint) {
+                auto const value = static_cast<utf8proc_int32_t>(codepoint);
+                return utf8proc_tolower(value) - value;
+            } };
+            return lowercase;
+        }
+
+        [[nodiscard]] char32_t map_case(char32_t const codepoint, simd::LetterCase const target) {
+            return static_cast<char32_t>(static_cast<std::int32_t>(codepoint) + case_mapping_table(target)[codepoint]);
+        }
+
+        struct SimpleCaseFolding final {
+            char32_t codepoint;
+            char32_t folded;
+        };
+
+        // The code points whose full case folding expands (status F in CaseFolding.txt), but that also have a simple
+        // case folding (status S), sorted by code point (Unicode 15.1).
+        // clang-format off
+        constexpr auto simple_case_foldings_besides_full = std::array{
+            SimpleCaseFolding{ 0x1E9E, 0x00DF },
+            SimpleCaseFolding{ 0x1F88, 0x1F80 }, SimpleCaseFolding{ 0x1F89, 0x1F81 },
+            SimpleCaseFolding{ 0x1F8A, 0x1F82 }, SimpleCaseFolding{ 0x1F8B, 0x1F83 },
+            SimpleCaseFolding{ 0x1F8C, 0x1F84 }, SimpleCaseFolding{ 0x1F8D, 0x1F85 },
+            SimpleCaseFolding{ 0x1F8E, 0x1F86 }, SimpleCaseFolding{ 0x1F8F, 0x1F87 },
+            SimpleCaseFolding{ 0x1F98, 0x1F90 }, SimpleCaseFolding{ 0x1F99, 0x1F91 },
+            SimpleCaseFolding{ 0x1F9A, 0x1F92 }, SimpleCaseFolding{ 0x1F9B, 0x1F93 },
+            SimpleCaseFolding{ 0x1F9C, 0x1F94 }, SimpleCaseFolding{ 0x1F9D, 0x1F95 },
+            SimpleCaseFolding{ 0x1F9E, 0x1F96 }, SimpleCaseFolding{ 0x1F9F, 0x1F97 },
+            SimpleCaseFolding{ 0x1FA8, 0x1FA0 }, SimpleCaseFolding{ 0x1FA9, 0x1FA1 },
+            SimpleCaseFolding{ 0x1FAA, 0x1FA2 }, SimpleCaseFolding{ 0x1FAB, 0x1FA3 },
+            SimpleCaseFolding{ 0x1FAC, 0x1FA4 }, SimpleCaseFolding{ 0x1FAD, 0x1FA5 },
+            SimpleCaseFolding{ 0x1FAE, 0x1FA6 }, SimpleCaseFolding{ 0x1FAF, 0x1FA7 },
+            SimpleCaseFolding{ 0x1FBC, 0x1FB3 },
+            SimpleCaseFolding{ 0x1FCC, 0x1FC3 },
+            SimpleCaseFolding{ 0x1FD3, 0x0390 },
+            SimpleCaseFolding{ 0x1FE3, 0x03B0 },
+            SimpleCaseFolding{ 0x1FFC, 0x1FF3 },
+            SimpleCaseFolding{ 0xFB05, 0xFB06 },
+        };
+        // clang-format on
+
+        static_assert(std::ranges::is_sorted(simple_case_foldings_besides_full, {}, &SimpleCaseFolding::codepoint));
+
+        [[nodiscard]] std::optional<char32_t> simple_case_folding_besides_full(char32_t const codepoint) {
+            auto const it = std::ranges::lower_bound(
+                    simple_case_foldings_besides_full,
+                    codepoint,
+                    {},
+                    &SimpleCaseFolding::codepoint
+            );
+            if (it == simple_case_foldings_besides_full.end() or it->codepoint != codepoint) {
+                return std::nullopt;
+            }
+            return it->folded;
+        }
+
+        [[nodiscard]] CaseMappingTable const& case_folding_table() {
+            static auto const table = CaseMappingTable{ [](char32_t const codepoint) {
+                auto const value = static_cast<utf8proc_int32_t>(codepoint);
+                if (not utf8proc_codepoint_valid(value)) {
+                    return 0;
+                }
+                auto folded = std::array<utf8proc_int32_t, 4>{};
+                auto const length = utf8proc_decompose_char(
+                        value,
+                        folded.data(),
+                        static_cast<utf8proc_ssize_t>(folded.size()),
+                        UTF8PROC_CASEFOLD,
+                        nullptr
+                );
+                if (length == 1) {
+                    return folded.front() - value;
+                }
+                // The full case folding (which is all that utf8proc provides) expands this code point, e.g. 'ß' to
+                // "ss". Unless there is an explicit simple case folding, the code point folds to itself. In
+                // particular, 'İ' does not fold to 'i' (that is the Turkic mapping, status T).
+                if (auto const folded = simple_case_folding_besides_full(codepoint)) {
+                    return static_cast<utf8proc_int32_t>(*folded) - value;
+                }
+                return 0;
+            } };
+            return table;
+        }
+
+        [[nodiscard]] char32_t fold_case(char32_t const codepoint) {
+            return static_cast<char32_t>(static_cast<std::int32_t>(codepoint) + case_folding_table()[codepoint]);
+        }
+
+        // Folds the input chunk by chunk into a buffer on the stack and hashes the chunks. The chunk boundaries only
+        // depend on the folded output, so inputs that are equal when ignoring case produce the same chunks.
+        class CaseFoldingHasher final {
+        private:
+            static constexpr auto buffer_size = std::size_t{ 256 };
+
+            std::array<char, buffer_size> m_buffer{};
+            std::size_t m_size{ 0 };
+            std::size_t m_hash{ 0 };
+
+        public:
+            [[nodiscard]] std::size_t available() const {
+                return buffer_size - m_size;
+            }
+
+            [[nodiscard]] char* end() {
+                return m_buffer.data() + m_size;
+            }
+
+            void commit(std::size_t const num_bytes) {
+                m_size += num_bytes;
+            }
+
+            void flush_if_full(std::size_t const num_bytes_needed) {
+                if (available() < num_bytes_needed) {
+                    flush();
+                }
+            }
+
+            [[nodiscard]] std::size_t finish() && {
+                flush();
+                return m_hash;
+            }
+
+        private:
+            void flush() {
+                auto const chunk_hash = std::hash<std::string_view>{}(std::string_view{ m_buffer.data(), m_size });
+                m_hash ^= chunk_hash + 0x9E37'79B9'7F4A'7C15 + (m_hash << 6) + (m_hash >> 2);
+                m_size = 0;
+            }
+        };
+
+        template<typename String>
+        void append_converted_case(std::string_view const input, String& output, simd::LetterCase const target) {
+            auto const input_bytes = reinterpret_cast<std::byte const*>(input.data());
+            // The output grows by the size of the input unless a case mapping changes the number of bytes
+            // of a char (which is rare).
+            auto write = output.size();
+            output.resize(write + input.size());
+            auto read = std::size_t{ 0 };
+            while (read < input.size()) {
+                auto const source = input.substr(read);
+                auto const num_ascii_bytes = simd::convert_ascii_case(source, output.data() + write, target);
+                read += num_ascii_bytes;
+                write += num_ascii_bytes;
+                if (read == input.size()) {
+                    break;
+                }
+
+                auto const num_bytes = utf8_sequence_length(input_bytes + read, input_bytes + input.size());
+                auto buffer = std::array<std::byte, 4>{};
+                auto const mapped = map_case(decode_utf8(input_bytes + read, num_bytes), target);
+                auto const num_mapped_bytes = encode_utf8(mapped, buffer.data());
+                read += num_bytes;
+
+                if (write + num_mapped_bytes + (input.size() - read) > output.size()) {
+                    output.resize(write + num_mapped_bytes + (input.size() - read));
+                }
+                std::memcpy(output.data() + write, buffer.data(), num_mapped_bytes);
+                write += num_mapped_bytes;
+            }
+            output.resize(write);
+        }
+    } // namespace
+
+    [[nodiscard]] std::string convert_case(std::string_view const input, simd::LetterCase const target) {
+        auto result = std::string{};
+        append_converted_case(input, result, target);
+        return result;
+    }
+
+    void convert_case(std::string_view const input, std::pmr::string& output, simd::LetterCase const target) {
+        append_converted_case(input, output, target);
+    }
+
+    void convert_case_in_place(std::string& data, simd::LetterCase const target) {
+        auto const bytes = reinterpret_cast<std::byte*>(data.data());
+        auto read = std::size_t{ 0 };
+        auto write = std::size_t{ 0 };
+        // `write` never overtakes `read`, so the ASCII kernel can safely convert within the same buffer
+        while (read < data.size()) {
+            auto const source = std::string_view{ data }.substr(read);
+            auto const num_ascii_bytes = simd::convert_ascii_case(source, data.data() + write, target);
+            read += num_ascii_bytes;
+            write += num_ascii_bytes;
+            if (read == data.size()) {
+                break;
+            }
+
+            auto const num_bytes = utf8_sequence_length(bytes + read, bytes + data.size());
+            auto buffer = std::array<std::byte, 4>{};
+            auto const mapped = map_case(decode_utf8(bytes + read, num_bytes), target);
+            auto const num_mapped_bytes = encode_utf8(mapped, buffer.data());
+            if (write + num_mapped_bytes > read + num_bytes) {
+                // The mapped char does not fit anymore. Continue in a new buffer that has enough space even
+                // if all remaining chars grow by 50% (which is the worst case for simple case mappings).
+                auto const remaining = data.size() - read;
+                auto result = std::string{};
+                result.reserve(write + remaining + remaining / 2);
+                result.append(data, 0, write);
+                append_converted_case(std::string_view{ data }.substr(read), result, target);
+                data = std::move(result);
+                return;
+            }
+            read += num_bytes;
+            std::memcpy(bytes + write, buffer.data(), num_mapped_bytes);
+            write += num_mapped_bytes;
+        }
+        data.resize(write);
+    }
+
+    [[nodiscard]] std::weak_ordering compare_ignore_case(std::string_view const lhs, std::string_view const rhs) {
+        auto const lhs_bytes = reinterpret_cast<std::byte const*>(lhs.data());
+        auto const rhs_bytes = reinterpret_cast<std::byte const*>(rhs.data());
+        auto lhs_position = std::size_t{ 0 };
+        auto rhs_position = std::size_t{ 0 };
+        while (true) {
+            auto const num_ascii_bytes =
+                    simd::ascii_common_prefix_ignore_case(lhs.substr(lhs_position), rhs.substr(rhs_position));
+            lhs_position += num_ascii_bytes;
+            rhs_position += num_ascii_bytes;
+            if (lhs_position == lhs.size() or rhs_position == rhs.size()) {
+                break;
+            }
+
+            auto const lhs_num_bytes = utf8_sequence_length(lhs_bytes + lhs_position, lhs_bytes + lhs.size());
+            auto const rhs_num_bytes = utf8_sequence_length(rhs_bytes + rhs_position, rhs_bytes + rhs.size());
+            auto const lhs_folded = fold_case(decode_utf8(lhs_bytes + lhs_position, lhs_num_bytes));
+            auto const rhs_folded = fold_case(decode_utf8(rhs_bytes + rhs_position, rhs_num_bytes));
+            if (lhs_folded != rhs_folded) {
+                return lhs_folded <=> rhs_folded;
+            }
+            lhs_position += lhs_num_bytes;
+            rhs_position += rhs_num_bytes;
+        }
+        return (lhs.size() - lhs_position) <=> (rhs.size() - rhs_position);
+    }
+
+    [[nodiscard]] bool equals_ignore_case(std::string_view const lhs, std::string_view const rhs) {
+        return compare_ignore_case(lhs, rhs) == std::weak_ordering::equivalent;
+    }
+
+    [[nodiscard]] std::size_t hash_ignore_case(std::string_view const input) {
+        auto const bytes = reinterpret_cast<std::byte const*>(input.data());
+        auto hasher = CaseFoldingHasher{};
+        auto position = std::size_t{ 0 };
+        while (position < input.size()) {
+            hasher.flush_if_full(1);
+            auto const source = input.substr(position, hasher.available());
+            auto const num_ascii_bytes = simd::convert_ascii_case(source, hasher.end(), simd::LetterCase::Lower);
+            hasher.commit(num_ascii_bytes);
+            position += num_ascii_bytes;
+            if (position == input.size() or num_ascii_bytes == source.size()) {
+                continue;
+            }
+
+            auto const num_bytes = utf8_sequence_length(bytes + position, bytes + input.size());
+            auto buffer = std::array<std::byte, 4>{};
+            auto const folded = fold_case(decode_utf8(bytes + position, num_bytes));
+            auto const num_folded_bytes = encode_utf8(folded, buffer.data());
+            hasher.flush_if_full(num_folded_bytes);
+            std::memcpy(hasher.end(), buffer.data(), num_folded_bytes);
+            hasher.commit(num_folded_bytes);
+            position += num_bytes;
+        }
+        return std::move(hasher).finish();
+    }
+} // namespace c2k::detail
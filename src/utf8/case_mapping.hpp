@@ -0,0 +1,22 @@
+#pragma once
+
+#include "../simd/simd.hpp"
+#include <compare>
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+
+namespace c2k::detail {
+    // Applies the simple case mapping of utf8proc to every code point of the (valid UTF-8) input.
+    [[nodiscard]] std::string convert_case(std::string_view input, simd::LetterCase target);
+    // Appends the converted input to `output`.
+    void convert_case(std::string_view input, std::pmr::string& output, simd::LetterCase target);
+    void convert_case_in_place(std::string& data, simd::LetterCase target);
+
+    // Case-insensitive operations based on the simple case folding of the (valid UTF-8) inputs. They fold
+    // the code points on the fly and never allocate.
+    [[nodiscard]] std::weak_ordering compare_ignore_case(std::string_view lhs, std::string_view rhs);
+    [[nodiscard]] bool equals_ignore_case(std::string_view lhs, std::string_view rhs);
+    [[nodiscard]] std::size_t hash_ignore_case(std::string_view input);
+} // namespace c2k::detail
@@ -2,38 +2,15 @@
 #include <utf8proc.h>
 
 namespace c2k {
-    [[nodiscard]] static utf8proc_int32_t to_utf8proc_codepoint(StaticVector<std::byte, 4> const codepoint) {
-        auto utf8proc_codepoint = utf8proc_int32_t{};
-        auto const result = utf8proc_iterate(
-                reinterpret_cast<utf8proc_uint8_t const*>(&codepoint.front()),
-                static_cast<utf8proc_ssize_t>(codepoint.size()),
-                &utf8proc_codepoint
-        );
-        assert(result >= 0);
-        return utf8proc_codepoint;
-    }
-
-    [[nodiscard]] static Utf8Char to_utf8char(utf8proc_int32_t const codepoint) {
+    [[nodiscard]] static tl::expected<Utf8Char, Utf8Error> to_utf8char(utf8proc_int32_t const codepoint) {
         auto buffer = std::array<utf8proc_uint8_t, 4>{};
         auto const num_bytes = utf8proc_encode_char(codepoint, buffer.data());
-        auto result = StaticVector<std::byte, 4>{};
-        for (auto i = decltype(num_bytes){ 0 }; i < num_bytes; ++i) {
-            result.push_back(static_cast<std::byte>(buffer.at(i)));
+        if (num_bytes <= 0) {
+            return tl::unexpected{ Utf8Error::InvalidUtf8Char };
         }
-        return Utf8Char::from_bytes_unchecked(std::span{ result.begin(), result.end() });
-    }
-
-    Utf8Char::Utf8Char(char const c) {
-        auto utf8proc_codepoint = utf8proc_int32_t{};
-        auto const result = utf8proc_iterate(
-                reinterpret_cast<utf8proc_uint8_t const*>(&c),
-                static_cast<utf8proc_ssize_t>(sizeof(c)),
-                &utf8proc_codepoint
+        return Utf8Char::from_bytes_unchecked(
+                std::as_bytes(std::span{ buffer.data(), static_cast<std::size_t>(num_bytes) })
         );
-        if (result < 0) {
-            throw InvalidUtf8Char{};
-        }
-        m_codepoint = Codepoint{ static_cast<std::byte>(c) };
     }
 
     [[nodiscard]] tl::expected<Utf8Char, Utf8Error> Utf8Char::from_bytes(std::span<std::byte const> const bytes) {
@@ -49,47 +26,36 @@ namespace c2k {
         if (result < 0) {
             return tl::unexpected{ Utf8Error::InvalidUtf8Char };
         }
-        auto codepoint = Codepoint{};
-        for (auto i = decltype(result){ 0 }; i < result; ++i) {
-            codepoint.push_back(bytes[i]);
-        }
-        return Utf8Char{ codepoint };
+        return from_bytes_unchecked(bytes.first(static_cast<std::size_t>(result)));
     }
 
     [[nodiscard]] tl::expected<Utf8Char, Utf8Error> Utf8Char::from_codepoint(std::int32_t const codepoint) {
         static_assert(std::same_as<std::remove_const_t<decltype(codepoint)>, utf8proc_int32_t>);
-        auto const result = to_utf8char(codepoint);
-        if (result.m_codepoint.empty()) {
+        // utf8proc_encode_char() also encodes surrogates, which are invalid in UTF-8. Noncharacters such as U+FFFE
+        // are valid scalar values and therefore accepted.
+        if (not utf8proc_codepoint_valid(codepoint)) {
             return tl::unexpected{ Utf8Error::InvalidUtf8Char };
         }
-        return result;
+        return to_utf8char(codepoint);
     }
 
     [[nodiscard]] std::int32_t Utf8Char::codepoint() const {
-        auto utf8proc_codepoint = utf8proc_int32_t{};
-        auto const result = utf8proc_iterate(
-                reinterpret_cast<utf8proc_uint8_t const*>(m_codepoint.data()),
-                static_cast<utf8proc_ssize_t>(m_codepoint.size()),
-                &utf8proc_codepoint
-        );
-        assert(result == m_codepoint.size());
-        static_assert(std::same_as<std::int32_t, utf8proc_int32_t>);
-        return utf8proc_codepoint;
+        return static_cast<std::int32_t>(detail::decode_utf8(m_bytes.data(), num_bytes()));
     }
 
     [[nodiscard]] bool Utf8Char::is_uppercase() const {
-        return utf8proc_isupper(to_utf8proc_codepoint(m_codepoint)) == 1;
+        return utf8proc_isupper(codepoint()) == 1;
     }
 
     [[nodiscard]] bool Utf8Char::is_lowercase() const {
-        return utf8proc_islower(to_utf8proc_codepoint(m_codepoint)) == 1;
+        return utf8proc_islower(codepoint()) == 1;
     }
 
     [[nodiscard]] Utf8Char Utf8Char::to_uppercase() const {
-        return to_utf8char(utf8proc_toupper(to_utf8proc_codepoint(m_codepoint)));
+        return to_utf8char(utf8proc_toupper(codepoint())).value();
     }
 
     [[nodiscard]] Utf8Char Utf8Char::to_lowercase() const {
-        return to_utf8char(utf8proc_tolower(to_utf8proc_codepoint(m_codepoint)));
+        return to_utf8char(utf8proc_tolower(codepoint())).value();
     }
 } // namespace c2k
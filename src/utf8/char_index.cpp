@@ -0,0 +1,71 @@
+#include "char_index.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace c2k::detail {
+    namespace {
+        [[nodiscard]] bool is_continuation_byte(char const byte) {
+            return (static_cast<unsigned char>(byte) & 0b1100'0000) == 0b1000'0000;
+        }
+    } // namespace
+
+    Utf8CharIndex::Utf8CharIndex(std::size_t const stride) : m_stride{ stride } {
+        assert(m_stride > 0);
+    }
+
+    void Utf8CharIndex::build_once(std::string_view const data) {
+        std::call_once(m_build_flag, [&] {
+            auto num_chars = std::size_t{ 0 };
+            for (auto i = std::size_t{ 0 }; i < data.size(); ++i) {
+                if (is_continuation_byte(data[i])) {
+                    continue;
+                }
+                if (num_chars % m_stride == 0) {
+                    m_offsets.push_back(i);
+                }
+                ++num_chars;
+            }
+            m_char_count = num_chars;
+            m_is_built.store(true, std::memory_order_release);
+        });
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t Utf8CharIndex::byte_offset_of(
+        std::string_view const data,
+        std::size_t const char_index
+    ) const { // clang-format on
+        assert(is_built());
+        if (char_index >= m_char_count) {
+            return data.size();
+        }
+        auto offset = m_offsets[char_index / m_stride];
+        for (auto remaining = char_index % m_stride; remaining > 0; --remaining) {
+            do {
+                ++offset;
+            } while (offset < data.size() and is_continuation_byte(data[offset]));
+        }
+        return offset;
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t Utf8CharIndex::char_index_of(
+        std::string_view const data,
+        std::size_t const byte_offset
+    ) const { // clang-format on
+        assert(is_built());
+        if (byte_offset >= data.size()) {
+            return m_char_count;
+        }
+        auto const block = static_cast<std::size_t>(
+                std::upper_bound(m_offsets.cbegin(), m_offsets.cend(), byte_offset) - m_offsets.cbegin() - 1
+        );
+        auto result = block * m_stride;
+        for (auto i = m_offsets[block]; i < byte_offset; ++i) {
+            if (not is_continuation_byte(data[i])) {
+                ++result;
+            }
+        }
+        return result;
+    }
+} // namespace c2k::detail
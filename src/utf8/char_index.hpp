@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace c2k::detail {
+    // Maps char indices to byte offsets (and vice versa) by remembering the byte offset of every
+    // `stride`-th character. The table is built on first use and is immutable afterwards, so it can
+    // be shared between (and concurrently used by) multiple strings with identical contents.
+    class Utf8CharIndex final {
+    private:
+        std::size_t m_stride;
+        std::once_flag m_build_flag;
+        std::atomic_bool m_is_built{ false };
+        std::vector<std::size_t> m_offsets;
+        std::size_t m_char_count{ 0 };
+
+    public:
+        explicit Utf8CharIndex(std::size_t stride);
+
+        void build_once(std::string_view data);
+
+        [[nodiscard]] bool is_built() const {
+            return m_is_built.load(std::memory_order_acquire);
+        }
+
+        [[nodiscard]] std::size_t char_count() const {
+            return m_char_count;
+        }
+
+        // Returns data.size() if char_index is out of range.
+        [[nodiscard]] std::size_t byte_offset_of(std::string_view data, std::size_t char_index) const;
+        [[nodiscard]] std::size_t char_index_of(std::string_view data, std::size_t byte_offset) const;
+    };
+} // namespace c2k::detail
@@ -0,0 +1,43 @@
+#include "char_width.hpp"
+#include "../simd/simd.hpp"
+#include "codepoint_table.hpp"
+#include <lib2k/utf8/ranges.hpp>
+#include <utf8proc.h>
+
+namespace c2k::detail {
+    namespace {
+        using CharWidthTable = CodepointTable<std::uint8_t>;
+
+        [[nodiscard]] CharWidthTable const& char_width_table() {
+            static auto const table = CharWidthTable{ [](char32_t const codepoint) {
+                return utf8proc_charwidth(static_cast<utf8proc_int32_t>(codepoint));
+            } };
+            return table;
+        }
+    } // namespace
+
+    [[nodiscard]] std::size_t calculate_char_width(std::string_view const input) {
+        auto const bytes = reinterpret_cast<std::byte const*>(input.data());
+        auto const end = bytes + input.size();
+        auto width = std::size_t{ 0 };
+        auto position = std::size_t{ 0 };
+        while (position < input.size()) {
+            auto const ascii = simd::measure_ascii_width(input.substr(position));
+            width += ascii.width;
+            position += ascii.num_bytes;
+            if (position == input.size()) {
+                break;
+            }
+
+            // Non-ASCII chars tend to come in runs (e.g. in CJK text), so we stay in this loop until we
+            // hit the next ASCII char instead of calling into the ASCII kernel for every single char.
+            auto const& table = char_width_table();
+            while (position < input.size() and static_cast<std::uint8_t>(bytes[position]) >= 0x80) {
+                auto const num_bytes = utf8_sequence_length(bytes + position, end);
+                width += table[decode_utf8(bytes + position, num_bytes)];
+                position += num_bytes;
+            }
+        }
+        return width;
+    }
+} // namespace c2k::detail
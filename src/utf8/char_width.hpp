@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+namespace c2k::detail {
+    // Sums up the widths (as defined by utf8proc) of all code points of the (valid UTF-8) input.
+    [[nodiscard]] std::size_t calculate_char_width(std::string_view input);
+} // namespace c2k::detail
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace c2k::detail {
+    // Two-stage lookup table that maps every code point to a value of type `T`. The code points are
+    // grouped into blocks of 256 and identical blocks are only stored once. Since most blocks map all
+    // of their code points to the same (default) value, the table stays small.
+    template<typename T>
+    class CodepointTable final {
+    private:
+        static constexpr auto block_bits = 8;
+        static constexpr auto block_size = std::size_t{ 1 } << block_bits;
+        static constexpr auto num_codepoints = std::size_t{ 0x11'0000 };
+        static constexpr auto num_blocks = num_codepoints / block_size;
+
+        using Block = std::array<T, block_size>;
+
+        std::vector<std::uint16_t> m_block_indices;
+        std::vector<T> m_values;
+
+    public:
+        template<std::invocable<char32_t> Generator>
+        explicit CodepointTable(Generator&& generator) : m_block_indices(num_blocks) {
+            auto unique_blocks = std::map<Block, std::uint16_t>{};
+            for (auto block_index = std::size_t{ 0 }; block_index < num_blocks; ++block_index) {
+                auto block = Block{};
+                for (auto i = std::size_t{ 0 }; i < block_size; ++i) {
+                    block[i] = static_cast<T>(generator(static_cast<char32_t>(block_index * block_size + i)));
+                }
+                auto const [iterator, inserted] =
+                        unique_blocks.try_emplace(block, static_cast<std::uint16_t>(unique_blocks.size()));
+                if (inserted) {
+                    m_values.insert(m_values.end(), block.cbegin(), block.cend());
+                }
+                m_block_indices[block_index] = iterator->second;
+            }
+        }
+
+        [[nodiscard]] T operator[](char32_t const codepoint) const {
+            assert(codepoint < num_codepoints);
+            auto const block_index = m_block_indices[codepoint >> block_bits];
+            return m_values[block_index * block_size + (codepoint & (block_size - 1))];
+        }
+    };
+} // namespace c2k::detail
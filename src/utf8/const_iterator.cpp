@@ -10,11 +10,7 @@ namespace c2k::detail {
         assert(result >= 0);
         m_next_char_num_bytes = static_cast<decltype(m_next_char_num_bytes)>(result);
 
-        auto codepoint = Utf8Char::Codepoint{};
-        for (auto i = decltype(m_next_char_num_bytes){ 0 }; i < m_next_char_num_bytes; ++i) {
-            codepoint.push_back(*(m_next_char_start + i));
-        }
-        m_next = Utf8Char{ codepoint };
+        m_next = Utf8Char::from_bytes_unchecked(std::span{ m_next_char_start, m_next_char_num_bytes });
     }
 
     Utf8ConstIterator::Utf8ConstIterator(
@@ -45,11 +41,7 @@ namespace c2k::detail {
         assert(result >= 0);
         m_next_char_num_bytes = static_cast<decltype(m_next_char_num_bytes)>(result);
 
-        auto codepoint = Utf8Char::Codepoint{};
-        for (auto i = decltype(m_next_char_num_bytes){ 0 }; i < m_next_char_num_bytes; ++i) {
-            codepoint.push_back(*(m_next_char_start + i));
-        }
-        m_next = Utf8Char{ codepoint };
+        m_next = Utf8Char::from_bytes_unchecked(std::span{ m_next_char_start, m_next_char_num_bytes });
 
         return *this;
     }
@@ -73,11 +65,7 @@ namespace c2k::detail {
         } while (is_continuation_byte(*pointer));
         m_next_char_start = reinterpret_cast<std::byte const*>(pointer);
         m_next_char_num_bytes = static_cast<std::uint8_t>(num_bytes);
-        auto codepoint = Utf8Char::Codepoint{};
-        for (auto i = std::size_t{ 0 }; i < num_bytes; ++i) {
-            codepoint.push_back(*(m_next_char_start + i));
-        }
-        m_next = Utf8Char{ codepoint };
+        m_next = Utf8Char::from_bytes_unchecked(std::span{ m_next_char_start, m_next_char_num_bytes });
         return *this;
     }
 
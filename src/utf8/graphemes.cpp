@@ -0,0 +1,100 @@
+#include <lib2k/utf8/graphemes.hpp>
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <tuple>
+#include <utf8proc.h>
+
+namespace c2k {
+    [[nodiscard]] bool Utf8GraphemeBreaker::is_break_before(char32_t const codepoint) {
+        auto const previous = m_previous;
+        m_previous = codepoint;
+        if (not m_has_previous) {
+            m_has_previous = true;
+            return true;
+        }
+        // Between two ASCII chars there is always a break (except for CR LF). An ASCII char also never
+        // contributes to the state of the following code point, so the state can be reset.
+        if (previous < 0x80 and codepoint < 0x80) {
+            m_state = 0;
+            return previous != U'\r' or codepoint != U'\n';
+        }
+        return utf8proc_grapheme_break_stateful(
+                static_cast<utf8proc_int32_t>(previous),
+                static_cast<utf8proc_int32_t>(codepoint),
+                &m_state
+        );
+    }
+
+    [[nodiscard]] std::optional<std::size_t> Utf8GraphemeBreaker::find_last_break(std::string_view const chunk) {
+        auto const begin = reinterpret_cast<std::byte const*>(chunk.data());
+        auto const end = begin + chunk.size();
+        auto result = std::optional<std::size_t>{};
+        for (auto position = begin; position < end;) {
+            auto const num_bytes = detail::utf8_sequence_length(position, end);
+            if (is_break_before(detail::decode_utf8(position, num_bytes))) {
+                result = static_cast<std::size_t>(position - begin);
+            }
+            position += num_bytes;
+        }
+        return result;
+    }
+} // namespace c2k
+
+namespace c2k::detail {
+    Utf8GraphemeIterator::Utf8GraphemeIterator(std::byte const* const start, std::byte const* const end)
+        : m_cluster_start{ start },
+          m_cluster_end{ start },
+          m_end{ end } {
+        if (start != end) {
+            std::ignore = m_breaker.is_break_before(decode_utf8(start, utf8_sequence_length(start, end)));
+            find_cluster_end();
+        }
+    }
+
+    void Utf8GraphemeIterator::find_cluster_end() {
+        auto position = m_cluster_start + utf8_sequence_length(m_cluster_start, m_end);
+        while (position < m_end) {
+            auto const num_bytes = utf8_sequence_length(position, m_end);
+            if (m_breaker.is_break_before(decode_utf8(position, num_bytes))) {
+                break;
+            }
+            position += num_bytes;
+        }
+        m_cluster_end = position;
+    }
+
+    [[nodiscard]] Utf8StringView Utf8GraphemeIterator::operator*() const {
+        return Utf8StringView::from_string_view_unchecked(std::string_view{
+                reinterpret_cast<char const*>(m_cluster_start),
+                reinterpret_cast<char const*>(m_cluster_end),
+        });
+    }
+
+    Utf8GraphemeIterator& Utf8GraphemeIterator::operator++() {
+        m_cluster_start = m_cluster_end;
+        if (m_cluster_start != m_end) {
+            find_cluster_end();
+        }
+        return *this;
+    }
+
+    [[nodiscard]] Utf8GraphemeIterator Utf8GraphemeIterator::operator++(int) {
+        auto const result = *this;
+        ++(*this);
+        return result;
+    }
+
+    [[nodiscard]] Utf8GraphemeIterator Utf8GraphemeRange::begin() const {
+        auto const start = reinterpret_cast<std::byte const*>(m_data.data());
+        return Utf8GraphemeIterator{ start, start + m_data.size() };
+    }
+
+    [[nodiscard]] Utf8GraphemeIterator Utf8GraphemeRange::end() const {
+        auto const end = reinterpret_cast<std::byte const*>(m_data.data() + m_data.size());
+        return Utf8GraphemeIterator{ end, end };
+    }
+
+    static_assert(std::forward_iterator<Utf8GraphemeIterator>);
+    static_assert(std::ranges::forward_range<Utf8GraphemeRange>);
+    static_assert(std::ranges::borrowed_range<Utf8GraphemeRange>);
+} // namespace c2k::detail
@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstring>
+#include <lib2k/utf8/interner.hpp>
+#include <new>
+
+namespace c2k {
+    namespace {
+        constexpr auto initial_table_capacity = std::size_t{ 1024 };
+        constexpr auto chunk_size = std::size_t{ 64 * 1024 };
+
+        [[nodiscard]] std::size_t round_up_to_alignment(std::size_t const num_bytes) {
+            constexpr auto alignment = alignof(detail::InternedString);
+            return (num_bytes + alignment - 1) / alignment * alignment;
+        }
+    } // namespace
+
+    // Open addressing with linear probing. Slots are filled exactly once and never cleared, so readers can
+    // probe without synchronizing with writers (other than through the atomic slots themselves).
+    struct Utf8Interner::Table final {
+        std::size_t capacity;
+        std::unique_ptr<std::atomic<detail::InternedString const*>[]> slots;
+
+        explicit Table(std::size_t const num_slots)
+            : capacity{ num_slots },
+              slots{ std::make_unique<std::atomic<detail::InternedString const*>[]>(num_slots) } { }
+
+        [[nodiscard]] detail::InternedString const* find(std::string_view const string, std::size_t const hash) const {
+            auto const mask = capacity - 1;
+            for (auto i = hash & mask;; i = (i + 1) & mask) {
+                auto const entry = slots[i].load(std::memory_order_acquire);
+                if (entry == nullptr) {
+                    return nullptr;
+                }
+                if (entry->hash == hash and entry->view() == string) {
+                    return entry;
+                }
+            }
+        }
+
+        void insert(detail::InternedString const* const entry) {
+            auto const mask = capacity - 1;
+            auto i = entry->hash & mask;
+            while (slots[i].load(std::memory_order_relaxed) != nullptr) {
+                i = (i + 1) & mask;
+            }
+            slots[i].store(entry, std::memory_order_release);
+        }
+    };
+
+    [[nodiscard]] Utf8StringView Utf8Atom::as_view() const {
+        auto result = Utf8StringView::from_string_view_unchecked(m_string->view());
+        result.m_is_ascii = m_string->is_ascii;
+        return result;
+    }
+
+    Utf8Interner::Utf8Interner() {
+        m_tables.push_back(std::make_unique<Table>(initial_table_capacity));
+        m_table.store(m_tables.back().get(), std::memory_order_release);
+    }
+
+    Utf8Interner::~Utf8Interner() = default;
+
+    [[nodiscard]] Utf8Atom Utf8Interner::intern(Utf8StringView const string) {
+        if (auto const atom = find(string)) {
+            return *atom;
+        }
+        auto const view = string.view();
+        auto const hash = std::hash<std::string_view>{}(view);
+
+        auto lock = std::scoped_lock{ m_mutex };
+        // another thread may have interned the string in the meantime
+        if (auto const entry = m_table.load(std::memory_order_relaxed)->find(view, hash)) {
+            return Utf8Atom{ entry };
+        }
+        if ((m_size + 1) * 4 > m_tables.back()->capacity * 3) {
+            grow();
+        }
+        auto const entry = store(view, hash, string.is_ascii());
+        m_tables.back()->insert(entry);
+        ++m_size;
+        return Utf8Atom{ entry };
+    }
+
+    [[nodiscard]] std::optional<Utf8Atom> Utf8Interner::find(Utf8StringView const string) const {
+        auto const view = string.view();
+        if (view.empty()) {
+            return Utf8Atom{};
+        }
+        auto const entry = m_table.load(std::memory_order_acquire)->find(view, std::hash<std::string_view>{}(view));
+        if (entry == nullptr) {
+            return std::nullopt;
+        }
+        return Utf8Atom{ entry };
+    }
+
+    [[nodiscard]] std::size_t Utf8Interner::size() const {
+        auto lock = std::scoped_lock{ m_mutex };
+        return m_size;
+    }
+
+    // clang-format off
+    [[nodiscard]] detail::InternedString const* Utf8Interner::store(
+        std::string_view const string,
+        std::size_t const hash,
+        bool const is_ascii
+    ) { // clang-format on
+        auto const num_bytes = round_up_to_alignment(sizeof(detail::InternedString) + string.size() + 1);
+        if (m_chunk_used + num_bytes > m_chunk_capacity) {
+            // strings that are larger than a chunk get a chunk of their own
+            m_chunk_capacity = std::max(chunk_size, num_bytes);
+            m_chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(m_chunk_capacity));
+            m_chunk_used = 0;
+        }
+        auto const memory = m_chunks.back().get() + m_chunk_used;
+        m_chunk_used += num_bytes;
+
+        auto const entry = new (memory) detail::InternedString{ hash, string.size(), is_ascii };
+        auto const data = reinterpret_cast<char*>(entry + 1);
+        std::memcpy(data, string.data(), string.size());
+        data[string.size()] = '\0';
+        return entry;
+    }
+
+    void Utf8Interner::grow() {
+        auto const& old_table = *m_tables.back();
+        auto new_table = std::make_unique<Table>(old_table.capacity * 2);
+        for (auto i = std::size_t{ 0 }; i < old_table.capacity; ++i) {
+            if (auto const entry = old_table.slots[i].load(std::memory_order_relaxed)) {
+                new_table->insert(entry);
+            }
+        }
+        // the old table is kept alive since other threads may still be reading from it
+        m_tables.push_back(std::move(new_table));
+        m_table.store(m_tables.back().get(), std::memory_order_release);
+    }
+} // namespace c2k
@@ -15,10 +15,8 @@ namespace c2k {
     }
 
     [[nodiscard]] Utf8StringView Utf8Literals::operator""_utf8view(char const* const str, std::size_t const length) {
-        auto const view = std::string_view{ str, length };
-        if (not Utf8String::is_valid_utf8(view)) {
-            throw InvalidUtf8String{};
-        }
-        return Utf8StringView::from_string_view_unchecked(view);
+        return Utf8StringView{
+            std::string_view{ str, length }
+        };
     }
 } // namespace c2k
@@ -0,0 +1,276 @@
+#include "normalizer.hpp"
+#include "../simd/simd.hpp"
+#include "codepoint_table.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utf8proc.h>
+#include <vector>
+
+namespace c2k::detail {
+    namespace {
+        enum class QuickCheckResult {
+            Yes,
+            No,
+            Maybe,
+        };
+
+        // Per code point: the canonical combining class in the lowest 8 bits, the following bits are flags.
+        using NormalizationTable = CodepointTable<std::uint16_t>;
+
+        constexpr auto combining_class_mask = std::uint16_t{ 0xFF };
+        constexpr auto not_nfd = std::uint16_t{ 1 << 8 };
+        constexpr auto not_nfkd = std::uint16_t{ 1 << 9 };
+        constexpr auto not_nfc = std::uint16_t{ 1 << 10 };
+        constexpr auto not_nfkc = std::uint16_t{ 1 << 11 };
+        // can be combined with a preceding code point during composition (NFC_QC and NFKC_QC are "Maybe")
+        constexpr auto composes_with_previous = std::uint16_t{ 1 << 12 };
+
+        constexpr auto max_decomposition_length = 32;
+
+        using Decomposition = std::array<utf8proc_int32_t, max_decomposition_length>;
+
+        [[nodiscard]] utf8proc_option_t options(NormalizationForm const form) {
+            switch (form) {
+                case NormalizationForm::Nfc:
+                    return static_cast<utf8proc_option_t>(UTF8PROC_STABLE | UTF8PROC_COMPOSE);
+                case NormalizationForm::Nfd:
+                    return static_cast<utf8proc_option_t>(UTF8PROC_STABLE | UTF8PROC_DECOMPOSE);
+                case NormalizationForm::Nfkc:
+                    return static_cast<utf8proc_option_t>(UTF8PROC_STABLE | UTF8PROC_COMPOSE | UTF8PROC_COMPAT);
+                case NormalizationForm::Nfkd:
+                    return static_cast<utf8proc_option_t>(UTF8PROC_STABLE | UTF8PROC_DECOMPOSE | UTF8PROC_COMPAT);
+            }
+            throw std::invalid_argument{ "invalid normalization form" };
+        }
+
+        // clang-format off
+        [[nodiscard]] std::size_t decompose(
+            char32_t const codepoint,
+            Decomposition& destination,
+            utf8proc_option_t const flags
+        ) { // clang-format on
+            auto const length = utf8proc_decompose_char(
+                    static_cast<utf8proc_int32_t>(codepoint),
+                    destination.data(),
+                    static_cast<utf8proc_ssize_t>(destination.size()),
+                    static_cast<utf8proc_option_t>(flags | UTF8PROC_DECOMPOSE),
+                    nullptr
+            );
+            assert(length > 0 and length <= max_decomposition_length);
+            return static_cast<std::size_t>(length);
+        }
+
+        [[nodiscard]] bool is_stable(char32_t const codepoint, utf8proc_option_t const flags) {
+            auto buffer = Decomposition{};
+            auto length = decompose(codepoint, buffer, flags);
+            if ((flags & UTF8PROC_COMPOSE) != 0) {
+                length = static_cast<std::size_t>(
+                        utf8proc_normalize_utf32(buffer.data(), static_cast<utf8proc_ssize_t>(length), flags)
+                );
+            }
+            return length == 1 and buffer.front() == static_cast<utf8proc_int32_t>(codepoint);
+        }
+
+        // Planes 4 to 13 do not contain any assigned code points.
+        [[nodiscard]] bool is_in_unassigned_plane(char32_t const codepoint) {
+            return codepoint >= 0x4'0000 and codepoint < 0xE'0000;
+        }
+
+        [[nodiscard]] bool is_hangul_syllable(char32_t const codepoint) {
+            return codepoint >= 0xAC00 and codepoint <= 0xD7A3;
+        }
+
+        // Returns nullptr for code points that are unassigned (and therefore stable in all normalization forms).
+        [[nodiscard]] utf8proc_property_t const* assigned_property(char32_t const codepoint) {
+            auto const value = static_cast<utf8proc_int32_t>(codepoint);
+            if (is_in_unassigned_plane(codepoint) or not utf8proc_codepoint_valid(value)) {
+                return nullptr;
+            }
+            auto const property = utf8proc_get_property(value);
+            return property->category == UTF8PROC_CATEGORY_CN ? nullptr : property;
+        }
+
+        // Code points without a decomposition map to themselves in all normalization forms. Hangul syllables are
+        // decomposed algorithmically, so their properties do not contain a decomposition.
+        [[nodiscard]] bool has_decomposition(char32_t const codepoint, utf8proc_property_t const& property) {
+            return property.decomp_seqindex != UINT16_MAX or is_hangul_syllable(codepoint);
+        }
+
+        [[nodiscard]] NormalizationTable create_normalization_table() {
+            static constexpr auto num_codepoints = char32_t{ 0x11'0000 };
+            // Every code point that is part of the canonical decomposition of a primary composite (except for
+            // the first one) may be combined with a preceding code point during composition.
+            auto composes = std::vector<char32_t>{};
+            for (auto codepoint = char32_t{ 0 }; codepoint < num_codepoints; ++codepoint) {
+                auto const property = assigned_property(codepoint);
+                if (property == nullptr or not has_decomposition(codepoint, *property)
+                    or not is_stable(codepoint, options(NormalizationForm::Nfc))) {
+                    continue;
+                }
+                auto buffer = Decomposition{};
+                auto const length = decompose(codepoint, buffer, options(NormalizationForm::Nfd));
+                for (auto i = std::size_t{ 1 }; i < length; ++i) {
+                    composes.push_back(static_cast<char32_t>(buffer[i]));
+                }
+            }
+            std::ranges::sort(composes);
+            auto const [first, last] = std::ranges::unique(composes);
+            composes.erase(first, last);
+
+            return NormalizationTable{ [&](char32_t const codepoint) {
+                auto const property = assigned_property(codepoint);
+                if (property == nullptr) {
+                    return std::uint16_t{ 0 };
+                }
+                auto result = static_cast<std::uint16_t>(property->combining_class);
+                if (has_decomposition(codepoint, *property)) {
+                    auto const add_flag_unless_stable = [&](NormalizationForm const form, std::uint16_t const flag) {
+                        if (not is_stable(codepoint, options(form))) {
+                            result |= flag;
+                        }
+                    };
+                    add_flag_unless_stable(NormalizationForm::Nfd, not_nfd);
+                    add_flag_unless_stable(NormalizationForm::Nfkd, not_nfkd);
+                    add_flag_unless_stable(NormalizationForm::Nfc, not_nfc);
+                    add_flag_unless_stable(NormalizationForm::Nfkc, not_nfkc);
+                }
+                if (std::ranges::binary_search(composes, codepoint)) {
+                    result |= composes_with_previous;
+                }
+                return result;
+            } };
+        }
+
+        [[nodiscard]] NormalizationTable const& normalization_table() {
+            static auto const table = create_normalization_table();
+            return table;
+        }
+
+        [[nodiscard]] std::uint16_t disallowed_flag(NormalizationForm const form) {
+            switch (form) {
+                case NormalizationForm::Nfc:
+                    return not_nfc;
+                case NormalizationForm::Nfd:
+                    return not_nfd;
+                case NormalizationForm::Nfkc:
+                    return not_nfkc;
+                case NormalizationForm::Nfkd:
+                    return not_nfkd;
+            }
+            throw std::invalid_argument{ "invalid normalization form" };
+        }
+
+        [[nodiscard]] bool is_composed(NormalizationForm const form) {
+            return form == NormalizationForm::Nfc or form == NormalizationForm::Nfkc;
+        }
+
+        // see https://unicode.org/reports/tr15/#Detecting_Normalization_Forms
+        [[nodiscard]] QuickCheckResult quick_check(std::string_view const input, NormalizationForm const form) {
+            auto const bytes = reinterpret_cast<std::byte const*>(input.data());
+            auto const end = bytes + input.size();
+            auto const disallowed = disallowed_flag(form);
+            auto const maybe = is_composed(form) ? composes_with_previous : std::uint16_t{ 0 };
+            auto result = QuickCheckResult::Yes;
+            auto position = std::size_t{ 0 };
+            while (position < input.size()) {
+                // ASCII chars are allowed in all forms and have a combining class of 0
+                position += simd::ascii_prefix_length(input.substr(position));
+                if (position == input.size()) {
+                    break;
+                }
+
+                auto const& table = normalization_table();
+                auto previous_combining_class = std::uint16_t{ 0 };
+                while (position < input.size() and static_cast<std::uint8_t>(bytes[position]) >= 0x80) {
+                    auto const num_bytes = utf8_sequence_length(bytes + position, end);
+                    auto const properties = table[decode_utf8(bytes + position, num_bytes)];
+                    position += num_bytes;
+                    auto const combining_class = static_cast<std::uint16_t>(properties & combining_class_mask);
+                    if ((combining_class != 0 and previous_combining_class > combining_class)
+                        or (properties & disallowed) != 0) {
+                        return QuickCheckResult::No;
+                    }
+                    if ((properties & maybe) != 0) {
+                        result = QuickCheckResult::Maybe;
+                    }
+                    previous_combining_class = combining_class;
+                }
+            }
+            return result;
+        }
+
+        [[nodiscard]] std::string normalize(std::string_view const input, NormalizationForm const form) {
+            auto output = static_cast<utf8proc_uint8_t*>(nullptr);
+            auto const length = utf8proc_map(
+                    reinterpret_cast<utf8proc_uint8_t const*>(input.data()),
+                    static_cast<utf8proc_ssize_t>(input.size()),
+                    &output,
+                    options(form)
+            );
+            if (length < 0) {
+                // the input is valid UTF-8, so this can only be caused by running out of memory
+                throw std::bad_alloc{};
+            }
+            auto const owner = std::unique_ptr<utf8proc_uint8_t, decltype(&std::free)>{ output, &std::free };
+            return std::string{ reinterpret_cast<char const*>(output), static_cast<std::size_t>(length) };
+        }
+    } // namespace
+
+    // clang-format off
+    [[nodiscard]] std::optional<std::string> normalize_if_needed(
+        std::string_view const input,
+        NormalizationForm const form
+    ) { // clang-format on
+        if (quick_check(input, form) == QuickCheckResult::Yes) {
+            return std::nullopt;
+        }
+        auto result = normalize(input, form);
+        if (result == input) {
+            return std::nullopt;
+        }
+        return result;
+    }
+
+    [[nodiscard]] bool is_normalized(std::string_view const input, NormalizationForm const form) {
+        switch (quick_check(input, form)) {
+            case QuickCheckResult::Yes:
+                return true;
+            case QuickCheckResult::No:
+                return false;
+            case QuickCheckResult::Maybe:
+                break;
+        }
+        return normalize(input, form) == input;
+    }
+} // namespace c2k::detail
+
+namespace c2k {
+    Utf8Normalized::Utf8Normalized(std::string_view const unchanged) : m_unchanged{ unchanged } { }
+
+    Utf8Normalized::Utf8Normalized(std::string normalized)
+        : m_normalized{ std::move(normalized) },
+          m_was_normalized{ false } { }
+
+    [[nodiscard]] Utf8StringView Utf8Normalized::view() const {
+        return Utf8StringView::from_string_view_unchecked(m_was_normalized ? m_unchanged : m_normalized);
+    }
+
+    [[nodiscard]] Utf8String Utf8Normalized::to_string() const& {
+        return Utf8String{ view() };
+    }
+
+    [[nodiscard]] Utf8String Utf8Normalized::to_string() && {
+        if (m_was_normalized) {
+            return Utf8String{ view() };
+        }
+        return Utf8String::from_validated_string(std::move(m_normalized), false);
+    }
+} // namespace c2k
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <lib2k/utf8/normalization.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace c2k::detail {
+    // The input must be valid UTF-8. Returns std::nullopt if the input already is in the requested form. This
+    // is decided by a quick check (see UAX #15) that does not allocate. Only if the quick check is inconclusive,
+    // the input is normalized and compared to the result.
+    [[nodiscard]] std::optional<std::string> normalize_if_needed(std::string_view input, NormalizationForm form);
+    [[nodiscard]] bool is_normalized(std::string_view input, NormalizationForm form);
+} // namespace c2k::detail
@@ -0,0 +1,126 @@
+#include "case_mapping.hpp"
+#include "replace.hpp"
+#include <lib2k/utf8/pmr_string.hpp>
+#include <limits>
+#include <utility>
+
+namespace c2k::pmr {
+    Utf8String::Utf8String(allocator_type const allocator) : m_data{ allocator } { }
+
+    Utf8String::Utf8String(Utf8StringView const view, allocator_type const allocator)
+        : m_data{ view.view(), allocator },
+          m_is_ascii{ view.m_is_ascii } { }
+
+    Utf8String::Utf8String(char const* const chars, allocator_type const allocator)
+        : Utf8String{ Utf8StringView{ chars }, allocator } { }
+
+    Utf8String::Utf8String(Utf8String const& other, allocator_type const allocator)
+        : m_data{ other.m_data, allocator },
+          m_is_ascii{ other.m_is_ascii } { }
+
+    Utf8String::Utf8String(Utf8String&& other, allocator_type const allocator)
+        : m_data{ std::move(other.m_data), allocator },
+          m_is_ascii{ other.m_is_ascii } { }
+
+    // clang-format off
+    [[nodiscard]] tl::expected<Utf8String, Utf8Error> Utf8String::from_chars(
+        std::string_view const chars,
+        allocator_type const allocator
+    ) { // clang-format on
+        if (not c2k::Utf8String::is_valid_utf8(chars)) {
+            return tl::unexpected{ Utf8Error::InvalidUtf8String };
+        }
+        return Utf8String{ Utf8StringView::from_string_view_unchecked(chars), allocator };
+    }
+
+    [[nodiscard]] Utf8StringView Utf8String::as_view() const {
+        auto result = Utf8StringView::from_string_view_unchecked(m_data);
+        result.m_is_ascii = m_is_ascii;
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::substring(
+        std::size_t const start,
+        std::size_t const num_chars,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        return Utf8String{ as_view().substring(start, num_chars), resource_or_own(resource) };
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::substring(
+        std::size_t const start,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        return Utf8String{ as_view().substring(start), resource_or_own(resource) };
+    }
+
+    [[nodiscard]] Utf8String Utf8String::to_uppercase(std::pmr::memory_resource* const resource) const {
+        auto result = Utf8String{ allocator_type{ resource_or_own(resource) } };
+        detail::convert_case(m_data, result.m_data, detail::simd::LetterCase::Upper);
+        result.m_is_ascii = m_is_ascii;
+        return result;
+    }
+
+    [[nodiscard]] Utf8String Utf8String::to_lowercase(std::pmr::memory_resource* const resource) const {
+        auto result = Utf8String{ allocator_type{ resource_or_own(resource) } };
+        detail::convert_case(m_data, result.m_data, detail::simd::LetterCase::Lower);
+        result.m_is_ascii = m_is_ascii;
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::replace(
+        Utf8StringView const to_replace,
+        Utf8StringView const replacement,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        return replace(
+                to_replace,
+                replacement,
+                MaxReplacementCount{ std::numeric_limits<std::underlying_type_t<MaxReplacementCount>>::max() },
+                resource
+        );
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::replace(
+        Utf8StringView const to_replace,
+        Utf8StringView const replacement,
+        MaxReplacementCount const max_num_replacements,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        auto result = Utf8String{ allocator_type{ resource_or_own(resource) } };
+        auto const searcher = Utf8Searcher{ to_replace };
+        detail::write_replaced(as_view(), searcher, replacement, 0, max_num_replacements, result.m_data);
+        result.m_is_ascii = m_is_ascii and replacement.m_is_ascii;
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] std::pmr::vector<Utf8String> Utf8String::split(
+        Utf8StringView const delimiter,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        auto const views = as_view().split(delimiter, resource_or_own(resource));
+        auto result = std::pmr::vector<Utf8String>{ resource_or_own(resource) };
+        result.reserve(views.size());
+        for (auto const view : views) {
+            // uses-allocator construction passes the memory resource of the vector to each element
+            result.emplace_back(view);
+        }
+        return result;
+    }
+
+    void Utf8String::append(Utf8Char const c) {
+        auto const bytes = c.as_string_view();
+        m_data.append(bytes);
+        m_is_ascii = m_is_ascii and bytes.size() == 1;
+    }
+
+    void Utf8String::append(Utf8StringView const view) {
+        m_data.append(view.view());
+        m_is_ascii = m_is_ascii and view.is_ascii();
+    }
+} // namespace c2k::pmr
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/searcher.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <stdexcept>
+#include <utility>
+
+namespace c2k::detail {
+    // Writes the result of Utf8StringView::replace() to `result` (a std::string or std::pmr::string). The matches
+    // are counted first, so that the result is allocated with its exact size and every byte is copied only once.
+    template<typename Chars>
+    // clang-format off
+    void write_replaced(
+        Utf8StringView const source,
+        Utf8Searcher const& to_replace,
+        Utf8StringView const replacement,
+        std::size_t const start_offset,
+        MaxReplacementCount const max_num_replacements,
+        Chars& result
+    ) { // clang-format on
+        auto const data = source.view();
+        auto const pattern = to_replace.needle().view();
+        auto const with = replacement.view();
+        auto const max_count = std::to_underlying(max_num_replacements);
+
+        if (max_count == 0) {
+            result.assign(data);
+            return;
+        }
+
+        if (start_offset == data.size()) {
+            result.assign(pattern.empty() ? with : data);
+            return;
+        }
+
+        if (pattern.empty()) {
+            // the replacement is inserted before every char and at the end
+            auto const num_chars = source.calculate_char_count();
+            result.resize(data.size() + (num_chars + 1) * with.size());
+            auto output = result.data();
+            output = std::ranges::copy(with, output).out;
+            for (auto i = std::size_t{ 0 }; i < data.size();) {
+                auto const length = std::size_t{ utf8_sequence_lengths[static_cast<std::uint8_t>(data[i])] };
+                output = std::ranges::copy(data.substr(i, length), output).out;
+                output = std::ranges::copy(with, output).out;
+                i += length;
+            }
+            return;
+        }
+
+        auto num_matches = std::size_t{ 0 };
+        for (auto position = to_replace.find_in(data, start_offset); position != std::string_view::npos;
+             position = to_replace.find_in(data, position + pattern.size())) {
+            ++num_matches;
+            if (num_matches == max_count) {
+                break;
+            }
+        }
+
+        result.resize(data.size() - num_matches * pattern.size() + num_matches * with.size());
+        auto output = result.data();
+        auto previous = std::size_t{ 0 };
+        auto position = start_offset;
+        for (auto i = std::size_t{ 0 }; i < num_matches; ++i) {
+            position = to_replace.find_in(data, position);
+            output = std::ranges::copy(data.substr(previous, position - previous), output).out;
+            output = std::ranges::copy(with, output).out;
+            position += pattern.size();
+            previous = position;
+        }
+        std::ranges::copy(data.substr(previous), output);
+    }
+
+    // Appends the parts of `source` between the occurrences of the delimiter to `result` (e.g. a std::vector
+    // or a std::pmr::vector of Utf8StringView).
+    template<typename Vector>
+    void split_into(Utf8StringView const source, Utf8Searcher const& delimiter, Vector& result) {
+        auto const delimiter_size = delimiter.needle().num_bytes();
+        if (delimiter_size == 0) {
+            throw std::invalid_argument{ "cannot split string with empty delimiter" };
+        }
+
+        auto const data = source.view();
+        auto part_start = std::size_t{ 0 };
+        for (auto position = delimiter.find_in(data); position != std::string_view::npos;
+             position = delimiter.find_in(data, part_start)) {
+            auto const part = data.substr(part_start, position - part_start);
+            result.push_back(Utf8StringView::from_string_view_unchecked(part));
+            part_start = position + delimiter_size;
+        }
+        result.push_back(Utf8StringView::from_string_view_unchecked(data.substr(part_start)));
+    }
+} // namespace c2k::detail
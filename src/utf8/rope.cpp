@@ -0,0 +1,449 @@
+#include "../simd/simd.hpp"
+#include <algorithm>
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/rope.hpp>
+#include <span>
+#include <stdexcept>
+
+namespace c2k {
+    namespace {
+        using detail::RopeNode;
+        using NodePointer = std::unique_ptr<RopeNode>;
+
+        // Chunks that are created from new text are only filled halfway, so that subsequent insertions can
+        // usually be done within an existing chunk.
+        constexpr auto initial_chunk_size = Utf8Rope::max_chunk_size / 2;
+
+        [[nodiscard]] std::size_t subtree_num_bytes(NodePointer const& node) {
+            return node == nullptr ? 0 : node->num_bytes;
+        }
+
+        [[nodiscard]] std::size_t subtree_num_chars(NodePointer const& node) {
+            return node == nullptr ? 0 : node->num_chars;
+        }
+
+        void update(RopeNode& node) {
+            node.num_bytes = subtree_num_bytes(node.left) + node.chunk.size() + subtree_num_bytes(node.right);
+            node.num_chars = subtree_num_chars(node.left) + node.chunk_num_chars + subtree_num_chars(node.right);
+        }
+
+        [[nodiscard]] bool is_continuation_byte(char const c) {
+            return (static_cast<unsigned char>(c) & 0b1100'0000) == 0b1000'0000;
+        }
+
+        [[nodiscard]] std::size_t chunk_byte_offset(RopeNode const& node, std::size_t const char_index) {
+            if (node.chunk_num_chars == node.chunk.size()) {
+                return char_index;
+            }
+            auto offset = std::size_t{ 0 };
+            for (auto i = std::size_t{ 0 }; i < char_index; ++i) {
+                offset += detail::utf8_sequence_lengths[static_cast<std::uint8_t>(node.chunk[offset])];
+            }
+            return offset;
+        }
+
+        [[nodiscard]] NodePointer merge(NodePointer left, NodePointer right) {
+            if (left == nullptr) {
+                return right;
+            }
+            if (right == nullptr) {
+                return left;
+            }
+            if (left->priority > right->priority) {
+                left->right = merge(std::move(left->right), std::move(right));
+                update(*left);
+                return left;
+            }
+            right->left = merge(std::move(left), std::move(right->left));
+            update(*right);
+            return right;
+        }
+
+        [[nodiscard]] NodePointer clone(NodePointer const& node) {
+            if (node == nullptr) {
+                return nullptr;
+            }
+            auto result = std::make_unique<RopeNode>();
+            result->chunk = node->chunk;
+            result->chunk_num_chars = node->chunk_num_chars;
+            result->priority = node->priority;
+            result->num_bytes = node->num_bytes;
+            result->num_chars = node->num_chars;
+            result->left = clone(node->left);
+            result->right = clone(node->right);
+            return result;
+        }
+
+        struct NodePosition final {
+            RopeNode const* node;
+            std::size_t node_start;
+        };
+
+        // Returns the node that contains the byte at `byte_offset` (or nullptr at the end of the text).
+        [[nodiscard]] NodePosition find_node(RopeNode const* node, std::size_t byte_offset) {
+            auto node_start = std::size_t{ 0 };
+            while (node != nullptr) {
+                auto const left_bytes = subtree_num_bytes(node->left);
+                if (byte_offset < left_bytes) {
+                    node = node->left.get();
+                } else if (byte_offset < left_bytes + node->chunk.size()) {
+                    return NodePosition{ node, node_start + left_bytes };
+                } else {
+                    byte_offset -= left_bytes + node->chunk.size();
+                    node_start += left_bytes + node->chunk.size();
+                    node = node->right.get();
+                }
+            }
+            return NodePosition{ nullptr, 0 };
+        }
+
+        // Inserts `text` into the chunk that contains the insertion point if the chunk has enough space left.
+        // clang-format off
+        [[nodiscard]] bool insert_in_place(
+            RopeNode& node,
+            std::size_t const char_index,
+            std::string_view const text,
+            std::size_t const text_num_chars
+        ) { // clang-format on
+            auto const left_chars = subtree_num_chars(node.left);
+            auto inserted = false;
+            if (char_index < left_chars) {
+                inserted = insert_in_place(*node.left, char_index, text, text_num_chars);
+            } else if (char_index <= left_chars + node.chunk_num_chars) {
+                if (node.chunk.size() + text.size() > Utf8Rope::max_chunk_size) {
+                    return false;
+                }
+                node.chunk.insert(chunk_byte_offset(node, char_index - left_chars), text);
+                node.chunk_num_chars += text_num_chars;
+                inserted = true;
+            } else {
+                auto const right_index = char_index - left_chars - node.chunk_num_chars;
+                inserted = insert_in_place(*node.right, right_index, text, text_num_chars);
+            }
+            if (inserted) {
+                node.num_bytes += text.size();
+                node.num_chars += text_num_chars;
+            }
+            return inserted;
+        }
+
+        // Erases the chars if they are all part of the same chunk (without erasing the whole chunk).
+        [[nodiscard]] bool erase_in_place(RopeNode& node, std::size_t const char_index, std::size_t const count) {
+            auto const left_chars = subtree_num_chars(node.left);
+            auto erased_bytes = std::size_t{ 0 };
+            if (char_index < left_chars) {
+                if (char_index + count > left_chars) {
+                    return false;
+                }
+                auto const old_num_bytes = node.left->num_bytes;
+                if (not erase_in_place(*node.left, char_index, count)) {
+                    return false;
+                }
+                erased_bytes = old_num_bytes - node.left->num_bytes;
+            } else if (char_index < left_chars + node.chunk_num_chars) {
+                auto const chunk_index = char_index - left_chars;
+                auto const is_whole_chunk = (chunk_index == 0 and count == node.chunk_num_chars);
+                if (chunk_index + count > node.chunk_num_chars or is_whole_chunk) {
+                    return false;
+                }
+                auto const begin = chunk_byte_offset(node, chunk_index);
+                auto end = begin;
+                for (auto i = std::size_t{ 0 }; i < count; ++i) {
+                    end += detail::utf8_sequence_lengths[static_cast<std::uint8_t>(node.chunk[end])];
+                }
+                node.chunk.erase(begin, end - begin);
+                node.chunk_num_chars -= count;
+                erased_bytes = end - begin;
+            } else {
+                if (node.right == nullptr) {
+                    return false;
+                }
+                auto const old_num_bytes = node.right->num_bytes;
+                if (not erase_in_place(*node.right, char_index - left_chars - node.chunk_num_chars, count)) {
+                    return false;
+                }
+                erased_bytes = old_num_bytes - node.right->num_bytes;
+            }
+            node.num_bytes -= erased_bytes;
+            node.num_chars -= count;
+            return true;
+        }
+
+        template<typename Function>
+        void for_each_chunk(NodePointer const& node, Function const& function) {
+            if (node == nullptr) {
+                return;
+            }
+            for_each_chunk(node->left, function);
+            function(std::string_view{ node->chunk });
+            for_each_chunk(node->right, function);
+        }
+    } // namespace
+
+    namespace detail {
+        Utf8RopeIterator::Utf8RopeIterator(RopeNode const* const root, std::size_t const byte_offset)
+            : m_root{ root } {
+            auto const [node, node_start] = find_node(root, byte_offset);
+            m_node = node;
+            m_node_start = (node == nullptr ? byte_offset : node_start);
+            m_offset = (node == nullptr ? 0 : byte_offset - node_start);
+        }
+
+        [[nodiscard]] Utf8Char Utf8RopeIterator::operator*() const {
+            auto const bytes = reinterpret_cast<std::byte const*>(m_node->chunk.data());
+            auto const length = utf8_sequence_length(bytes + m_offset, bytes + m_node->chunk.size());
+            return Utf8Char::from_bytes_unchecked(std::span{ bytes + m_offset, length });
+        }
+
+        Utf8RopeIterator& Utf8RopeIterator::operator++() {
+            m_offset += utf8_sequence_lengths[static_cast<std::uint8_t>(m_node->chunk[m_offset])];
+            if (m_offset == m_node->chunk.size()) {
+                *this = Utf8RopeIterator{ m_root, m_node_start + m_offset };
+            }
+            return *this;
+        }
+    } // namespace detail
+
+    Utf8Rope::Utf8Rope(Utf8StringView const text) : m_root{ build(text) } { }
+
+    Utf8Rope::Utf8Rope(Utf8Rope const& other)
+        : m_root{ clone(other.m_root) },
+          m_random_state{ other.m_random_state } { }
+
+    Utf8Rope& Utf8Rope::operator=(Utf8Rope const& other) {
+        if (this != &other) {
+            *this = Utf8Rope{ other };
+        }
+        return *this;
+    }
+
+    Utf8Rope::~Utf8Rope() = default;
+
+    void Utf8Rope::insert(std::size_t const char_index, Utf8StringView const text) {
+        if (char_index > char_count()) {
+            throw std::out_of_range{ "cannot insert into rope beyond its end" };
+        }
+        if (text.is_empty()) {
+            return;
+        }
+        auto const text_num_chars = text.calculate_char_count();
+        if (m_root != nullptr and insert_in_place(*m_root, char_index, text.view(), text_num_chars)) {
+            return;
+        }
+        auto [left, right] = split(std::move(m_root), char_index);
+        m_root = merge(merge(std::move(left), build(text)), std::move(right));
+    }
+
+    void Utf8Rope::append(Utf8StringView const text) {
+        insert(char_count(), text);
+    }
+
+    void Utf8Rope::erase(std::size_t const char_index, std::size_t num_chars) {
+        if (char_index > char_count()) {
+            throw std::out_of_range{ "cannot erase from rope beyond its end" };
+        }
+        num_chars = std::min(num_chars, char_count() - char_index);
+        if (num_chars == 0 or erase_in_place(*m_root, char_index, num_chars)) {
+            return;
+        }
+        auto [left, rest] = split(std::move(m_root), char_index);
+        auto [erased, right] = split(std::move(rest), num_chars);
+        m_root = merge(std::move(left), std::move(right));
+    }
+
+    void Utf8Rope::clear() {
+        m_root = nullptr;
+    }
+
+    [[nodiscard]] Utf8Char Utf8Rope::char_at(std::size_t char_index) const {
+        if (char_index >= char_count()) {
+            throw std::out_of_range{ "char index out of range" };
+        }
+        auto node = m_root.get();
+        while (true) {
+            auto const left_chars = subtree_num_chars(node->left);
+            if (char_index < left_chars) {
+                node = node->left.get();
+            } else if (char_index < left_chars + node->chunk_num_chars) {
+                auto const bytes = reinterpret_cast<std::byte const*>(node->chunk.data());
+                auto const offset = chunk_byte_offset(*node, char_index - left_chars);
+                auto const length = detail::utf8_sequence_length(bytes + offset, bytes + node->chunk.size());
+                return Utf8Char::from_bytes_unchecked(std::span{ bytes + offset, length });
+            } else {
+                char_index -= left_chars + node->chunk_num_chars;
+                node = node->right.get();
+            }
+        }
+    }
+
+    [[nodiscard]] Utf8Rope::ConstIterator Utf8Rope::begin() const {
+        return ConstIterator{ m_root.get(), 0 };
+    }
+
+    [[nodiscard]] Utf8Rope::ConstIterator Utf8Rope::end() const {
+        return ConstIterator{ m_root.get(), num_bytes() };
+    }
+
+    [[nodiscard]] Utf8Rope::ConstIterator Utf8Rope::iterator_at(std::size_t const char_index) const {
+        if (char_index > char_count()) {
+            throw std::out_of_range{ "char index out of range" };
+        }
+        return ConstIterator{ m_root.get(), byte_offset_of(char_index) };
+    }
+
+    [[nodiscard]] Utf8Rope::ConstIterator Utf8Rope::find(Utf8StringView const needle) const {
+        return find(needle, 0);
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8Rope::ConstIterator Utf8Rope::find(
+        Utf8StringView const needle,
+        std::size_t const start_char_index
+    ) const { // clang-format on
+        if (start_char_index > char_count()) {
+            return end();
+        }
+        auto const start = byte_offset_of(start_char_index);
+        auto const pattern = needle.view();
+        if (pattern.empty()) {
+            return ConstIterator{ m_root.get(), start };
+        }
+
+        // the last bytes before the current chunk (for matches that span chunk boundaries)
+        auto tail = std::string{};
+        auto [node, node_start] = find_node(m_root.get(), start);
+        auto offset = start - node_start;
+        while (node != nullptr) {
+            auto const chunk = std::string_view{ node->chunk }.substr(offset);
+            auto const chunk_start = node_start + offset;
+            if (not tail.empty()) {
+                auto const window = tail + std::string{ chunk.substr(0, pattern.size() - 1) };
+                auto const position = window.find(pattern);
+                if (position != std::string::npos and position < tail.size()) {
+                    return ConstIterator{ m_root.get(), chunk_start - tail.size() + position };
+                }
+            }
+            if (auto const position = chunk.find(pattern); position != std::string_view::npos) {
+                return ConstIterator{ m_root.get(), chunk_start + position };
+            }
+            tail += chunk.substr(chunk.size() - std::min(chunk.size(), pattern.size() - 1));
+            tail.erase(0, tail.size() - std::min(tail.size(), pattern.size() - 1));
+
+            auto const next = find_node(m_root.get(), node_start + node->chunk.size());
+            node = next.node;
+            node_start = next.node_start;
+            offset = 0;
+        }
+        return end();
+    }
+
+    [[nodiscard]] std::vector<Utf8StringView> Utf8Rope::chunks() const {
+        auto result = std::vector<Utf8StringView>{};
+        for_each_chunk(m_root, [&](std::string_view const chunk) {
+            result.push_back(Utf8StringView::from_string_view_unchecked(chunk));
+        });
+        return result;
+    }
+
+    [[nodiscard]] Utf8String Utf8Rope::to_string() const {
+        auto result = std::string{};
+        result.reserve(num_bytes());
+        for_each_chunk(m_root, [&](std::string_view const chunk) { result += chunk; });
+        return Utf8String::from_string_unchecked(std::move(result));
+    }
+
+    [[nodiscard]] bool Utf8Rope::operator==(Utf8StringView const other) const {
+        if (other.num_bytes() != num_bytes()) {
+            return false;
+        }
+        auto remaining = other.view();
+        auto result = true;
+        for_each_chunk(m_root, [&](std::string_view const chunk) {
+            result = result and remaining.starts_with(chunk);
+            remaining.remove_prefix(chunk.size());
+        });
+        return result;
+    }
+
+    [[nodiscard]] std::uint32_t Utf8Rope::next_priority() {
+        // xorshift32
+        m_random_state ^= m_random_state << 13;
+        m_random_state ^= m_random_state >> 17;
+        m_random_state ^= m_random_state << 5;
+        return m_random_state;
+    }
+
+    [[nodiscard]] std::unique_ptr<RopeNode> Utf8Rope::make_node(std::string chunk) {
+        auto result = std::make_unique<RopeNode>();
+        result->chunk_num_chars = detail::simd::count_chars(chunk);
+        result->chunk = std::move(chunk);
+        result->priority = next_priority();
+        update(*result);
+        return result;
+    }
+
+    [[nodiscard]] std::unique_ptr<RopeNode> Utf8Rope::build(Utf8StringView const text) {
+        auto remaining = text.view();
+        auto result = NodePointer{};
+        while (not remaining.empty()) {
+            auto length = std::min(remaining.size(), initial_chunk_size);
+            while (length < remaining.size() and is_continuation_byte(remaining[length])) {
+                --length;
+            }
+            result = merge(std::move(result), make_node(std::string{ remaining.substr(0, length) }));
+            remaining.remove_prefix(length);
+        }
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] std::pair<std::unique_ptr<RopeNode>, std::unique_ptr<RopeNode>> Utf8Rope::split(
+        std::unique_ptr<RopeNode> node,
+        std::size_t const char_index
+    ) { // clang-format on
+        if (node == nullptr) {
+            return {};
+        }
+        auto const left_chars = subtree_num_chars(node->left);
+        if (char_index <= left_chars) {
+            auto [left, right] = split(std::move(node->left), char_index);
+            node->left = std::move(right);
+            update(*node);
+            return { std::move(left), std::move(node) };
+        }
+        if (char_index >= left_chars + node->chunk_num_chars) {
+            auto [left, right] = split(std::move(node->right), char_index - left_chars - node->chunk_num_chars);
+            node->right = std::move(left);
+            update(*node);
+            return { std::move(node), std::move(right) };
+        }
+
+        // the split point is within the chunk of this node
+        auto const chunk_index = char_index - left_chars;
+        auto const offset = chunk_byte_offset(*node, chunk_index);
+        auto tail = make_node(node->chunk.substr(offset));
+        node->chunk.resize(offset);
+        node->chunk_num_chars = chunk_index;
+        auto right = merge(std::move(tail), std::move(node->right));
+        update(*node);
+        return { std::move(node), std::move(right) };
+    }
+
+    [[nodiscard]] std::size_t Utf8Rope::byte_offset_of(std::size_t char_index) const {
+        auto result = std::size_t{ 0 };
+        auto node = m_root.get();
+        while (node != nullptr) {
+            auto const left_chars = subtree_num_chars(node->left);
+            if (char_index < left_chars) {
+                node = node->left.get();
+            } else if (char_index < left_chars + node->chunk_num_chars) {
+                return result + subtree_num_bytes(node->left) + chunk_byte_offset(*node, char_index - left_chars);
+            } else {
+                char_index -= left_chars + node->chunk_num_chars;
+                result += subtree_num_bytes(node->left) + node->chunk.size();
+                node = node->right.get();
+            }
+        }
+        return result;
+    }
+} // namespace c2k
@@ -0,0 +1,42 @@
+#include "../simd/simd.hpp"
+#include <cstring>
+#include <lib2k/utf8/searcher.hpp>
+
+namespace c2k {
+    Utf8Searcher::Utf8Searcher(Utf8StringView const needle) : m_needle{ needle.view() } {
+        if (m_needle.size() < min_horspool_needle_size) {
+            return;
+        }
+        m_shifts.assign(256, m_needle.size());
+        for (auto i = std::size_t{ 0 }; i < m_needle.size() - 1; ++i) {
+            m_shifts[static_cast<unsigned char>(m_needle[i])] = m_needle.size() - 1 - i;
+        }
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t Utf8Searcher::find_in(
+        std::string_view const haystack,
+        std::size_t const start_offset
+    ) const { // clang-format on
+        if (start_offset > haystack.size()) {
+            return std::string_view::npos;
+        }
+        if (m_shifts.empty()) {
+            auto const position = detail::simd::find_substring(haystack.substr(start_offset), m_needle);
+            return position == std::string_view::npos ? position : start_offset + position;
+        }
+
+        auto const last = m_needle.size() - 1;
+        auto const last_byte = m_needle.back();
+        auto position = start_offset;
+        while (haystack.size() - position >= m_needle.size()) {
+            auto const window_last_byte = haystack[position + last];
+            if (window_last_byte == last_byte
+                and std::memcmp(haystack.data() + position, m_needle.data(), last) == 0) {
+                return position;
+            }
+            position += m_shifts[static_cast<unsigned char>(window_last_byte)];
+        }
+        return std::string_view::npos;
+    }
+} // namespace c2k
@@ -0,0 +1,72 @@
+#include "../simd/simd.hpp"
+#include "utf8_sequence.hpp"
+#include <algorithm>
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/stream_validator.hpp>
+
+namespace c2k {
+    namespace {
+        // Returns the offset of the char that is cut off at the end of `chunk` (or the size of `chunk`
+        // if there is none). Since chars are at most 4 bytes long, only the last 3 bytes have to be checked.
+        [[nodiscard]] std::size_t find_incomplete_tail(std::string_view const chunk) {
+            auto const bytes = reinterpret_cast<unsigned char const*>(chunk.data());
+            for (auto i = std::size_t{ 1 }; i <= std::min(chunk.size(), std::size_t{ 3 }); ++i) {
+                auto const byte = bytes[chunk.size() - i];
+                if ((byte & 0b1100'0000) == 0b1000'0000) {
+                    continue;
+                }
+                return detail::utf8_sequence_lengths[byte] > i ? chunk.size() - i : chunk.size();
+            }
+            return chunk.size();
+        }
+    } // namespace
+
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> Utf8StreamValidator::feed(std::string_view chunk) {
+        if (m_has_error) {
+            return tl::unexpected{ Utf8Error::InvalidUtf8String };
+        }
+        auto const chunk_size = chunk.size();
+
+        if (m_num_pending > 0) {
+            // complete the char that has been started by the previous chunk
+            auto const num_missing = detail::utf8_sequence_lengths[m_pending[0]] - m_num_pending;
+            auto const num_taken = std::min(num_missing, chunk.size());
+            auto const pending_end = m_pending.begin() + static_cast<std::ptrdiff_t>(m_num_pending);
+            std::ranges::copy(chunk.substr(0, num_taken), pending_end);
+            m_num_pending += num_taken;
+            chunk.remove_prefix(num_taken);
+            auto const sequence = detail::inspect_utf8_sequence(m_pending.data(), m_num_pending);
+            if (sequence.status == detail::Utf8SequenceStatus::Invalid) {
+                m_has_error = true;
+                return tl::unexpected{ Utf8Error::InvalidUtf8String };
+            }
+            if (sequence.status == detail::Utf8SequenceStatus::Truncated) {
+                return std::size_t{ 0 };
+            }
+            m_num_complete_bytes += m_num_pending;
+            m_num_pending = 0;
+        }
+
+        auto const tail_offset = find_incomplete_tail(chunk);
+        auto const tail = chunk.substr(tail_offset);
+        auto const tail_bytes = reinterpret_cast<unsigned char const*>(tail.data());
+        if (not detail::simd::validate_utf8(chunk.substr(0, tail_offset)).is_valid
+            or (not tail.empty()
+                and detail::inspect_utf8_sequence(tail_bytes, tail.size()).status
+                            != detail::Utf8SequenceStatus::Truncated)) {
+            m_has_error = true;
+            return tl::unexpected{ Utf8Error::InvalidUtf8String };
+        }
+        std::ranges::copy(tail_bytes, tail_bytes + tail.size(), m_pending.begin());
+        m_num_pending = tail.size();
+        m_num_complete_bytes += tail_offset;
+        return chunk_size - tail.size();
+    }
+
+    [[nodiscard]] tl::expected<void, Utf8Error> Utf8StreamValidator::finish() const {
+        if (m_has_error or m_num_pending > 0) {
+            return tl::unexpected{ Utf8Error::InvalidUtf8String };
+        }
+        return {};
+    }
+} // namespace c2k
@@ -1,18 +1,75 @@
+#include "../simd/simd.hpp"
+#include "case_mapping.hpp"
+#include "char_index.hpp"
+#include "normalizer.hpp"
+#include "utf8_sequence.hpp"
 #include "lib2k/utf8/string_view.hpp"
 #include <lib2k/utf8/char.hpp>
+#include <lib2k/utf8/searcher.hpp>
 #include <lib2k/utf8/string.hpp>
-#include <utf8proc.h>
+#include <algorithm>
+#include <cstring>
 
 namespace c2k {
+    namespace {
+        struct IllFormedSubsequence final {
+            std::size_t offset;
+            std::size_t length;
+        };
+
+        constexpr auto replacement_character = std::string_view{ "\xEF\xBF\xBD" };
+
+        [[nodiscard]] std::vector<IllFormedSubsequence> find_ill_formed_subsequences(std::string_view const chars) {
+            auto const bytes = reinterpret_cast<unsigned char const*>(chars.data());
+            auto result = std::vector<IllFormedSubsequence>{};
+            auto i = std::size_t{ 0 };
+            while (i < chars.size()) {
+                if (bytes[i] < 0x80) {
+                    i += detail::simd::ascii_prefix_length(chars.substr(i));
+                    continue;
+                }
+                auto const sequence = detail::inspect_utf8_sequence(bytes + i, chars.size() - i);
+                if (sequence.status != detail::Utf8SequenceStatus::Valid) {
+                    result.push_back(IllFormedSubsequence{ i, sequence.length });
+                }
+                i += sequence.length;
+            }
+            return result;
+        }
+
+        // The replacement character is never shorter than the subsequence it replaces. Therefore, the string is
+        // grown first and then filled from the back so that no byte is overwritten before it has been moved.
+        void replace_ill_formed_subsequences(std::string& chars, std::vector<IllFormedSubsequence> const& errors) {
+            auto read_end = chars.size();
+            auto write_end = chars.size();
+            for (auto const& error : errors) {
+                write_end += replacement_character.size() - error.length;
+            }
+            chars.resize(write_end);
+            for (auto it = errors.crbegin(); it != errors.crend(); ++it) {
+                auto const valid_begin = it->offset + it->length;
+                auto const num_valid_bytes = read_end - valid_begin;
+                write_end -= num_valid_bytes;
+                std::memmove(chars.data() + write_end, chars.data() + valid_begin, num_valid_bytes);
+                write_end -= replacement_character.size();
+                std::ranges::copy(replacement_character, chars.begin() + static_cast<std::ptrdiff_t>(write_end));
+                read_end = it->offset;
+            }
+        }
+    } // namespace
+
     [[nodiscard]] Utf8String operator+(Utf8Char const c, Utf8String const& string) {
         auto result = Utf8String{};
+        result.reserve(c.as_string_view().size() + string.num_bytes());
         result += c;
         result += string;
         return result;
     }
 
     [[nodiscard]] Utf8String operator+(Utf8String const& lhs, Utf8String const& rhs) {
-        auto result = lhs;
+        auto result = Utf8String{};
+        result.reserve(lhs.num_bytes() + rhs.num_bytes());
+        result += lhs;
         result += rhs;
         return result;
     }
@@ -21,54 +78,127 @@ namespace c2k {
         : m_data{
               reinterpret_cast<char const*>(begin.m_next_char_start),
               reinterpret_cast<char const*>(end.m_next_char_start),
-          } { }
+          },
+          m_is_ascii{ detail::simd::is_ascii(m_data) } { }
 
     [[nodiscard]] Utf8String Utf8String::from_string_unchecked(std::string data) {
-        auto result = Utf8String{};
-        result.m_data = std::move(data);
-        return result;
+        auto const is_ascii = detail::simd::is_ascii(data);
+        return from_validated_string(std::move(data), is_ascii);
     }
 
     Utf8String::Utf8String(std::string string) {
-        if (not is_valid_utf8(string)) {
+        auto const validation = detail::simd::validate_utf8(string);
+        if (not validation.is_valid) {
             throw InvalidUtf8String{};
         }
         m_data = std::move(string);
+        m_is_ascii = validation.is_ascii;
     }
 
     Utf8String::Utf8String(char const* const string) {
         if (string == nullptr) {
             throw std::invalid_argument{ "cannot create Utf8String from nullptr" };
         }
-        if (not is_valid_utf8(string)) {
+        auto const validation = detail::simd::validate_utf8(string);
+        if (not validation.is_valid) {
             throw InvalidUtf8String{};
         }
         m_data = std::string{ string };
+        m_is_ascii = validation.is_ascii;
     }
 
-    Utf8String::Utf8String(Utf8StringView const view) : m_data{ view.m_view } { }
+    Utf8String::Utf8String(Utf8StringView const view)
+        : m_data{ view.m_view },
+          m_is_ascii{ view.m_is_ascii or detail::simd::is_ascii(view.m_view) } { }
 
     [[nodiscard]] tl::expected<Utf8String, Utf8Error> Utf8String::from_chars(std::string chars) {
-        if (not is_valid_utf8(chars)) {
+        auto const validation = detail::simd::validate_utf8(chars);
+        if (not validation.is_valid) {
             return tl::unexpected{ Utf8Error::InvalidUtf8String };
         }
-        return from_string_unchecked(std::move(chars));
+        return from_validated_string(std::move(chars), validation.is_ascii);
+    }
+
+    [[nodiscard]] Utf8String Utf8String::from_chars_lossy(std::string chars) {
+        return from_chars_lossy(std::move(chars), Utf8ErrorReporting::FirstError).string;
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8RepairResult Utf8String::from_chars_lossy(
+        std::string chars,
+        Utf8ErrorReporting const reporting
+    ) { // clang-format on
+        auto const validation = detail::simd::validate_utf8(chars);
+        if (validation.is_valid) {
+            return Utf8RepairResult{ from_validated_string(std::move(chars), validation.is_ascii), {} };
+        }
+        auto const errors = find_ill_formed_subsequences(chars);
+        replace_ill_formed_subsequences(chars, errors);
+        auto error_offsets = std::vector<std::size_t>{};
+        if (reporting == Utf8ErrorReporting::FirstError) {
+            error_offsets.push_back(errors.front().offset);
+        } else {
+            error_offsets.reserve(errors.size());
+            std::ranges::transform(errors, std::back_inserter(error_offsets), &IllFormedSubsequence::offset);
+        }
+        return Utf8RepairResult{ from_validated_string(std::move(chars), false), std::move(error_offsets) };
     }
 
     [[nodiscard]] bool Utf8String::is_valid_utf8(std::string_view const string) {
-        auto current = string.data();
-        auto const end = current + string.length();
-        while (current < end) {
-            auto const bytes_remaining = static_cast<utf8proc_ssize_t>(end - current);
-            auto codepoint = utf8proc_int32_t{};
-            auto const result =
-                    utf8proc_iterate(reinterpret_cast<utf8proc_uint8_t const*>(current), bytes_remaining, &codepoint);
-            if (result < 0) {
-                return false;
-            }
-            current += result;
+        return detail::simd::validate_utf8(string).is_valid;
+    }
+
+    [[nodiscard]] bool Utf8String::is_ascii() const {
+        return m_is_ascii or detail::simd::is_ascii(m_data);
+    }
+
+    void Utf8String::enable_char_index() {
+        if (m_char_index == nullptr) {
+            m_char_index = std::make_shared<detail::Utf8CharIndex>(char_index_stride);
+        }
+    }
+
+    void Utf8String::disable_char_index() {
+        m_char_index = nullptr;
+    }
+
+    [[nodiscard]] bool Utf8String::has_char_index() const {
+        return m_char_index != nullptr;
+    }
+
+    [[nodiscard]] Utf8String::ConstIterator Utf8String::iterator_at(std::size_t const char_index) const {
+        return advanced(cbegin(), char_index);
+    }
+
+    [[nodiscard]] std::size_t Utf8String::char_index_of(ConstIterator const& position) const {
+        if (m_is_ascii) {
+            return byte_offset(position);
+        }
+        if (m_char_index != nullptr) {
+            return char_index().char_index_of(m_data, byte_offset(position));
+        }
+        return static_cast<std::size_t>(position - cbegin());
+    }
+
+    // clang-format off
+    [[nodiscard]] std::size_t Utf8String::distance(
+        ConstIterator const& first,
+        ConstIterator const& last
+    ) const { // clang-format on
+        if (m_is_ascii or m_char_index != nullptr) {
+            return char_index_of(last) - char_index_of(first);
+        }
+        return static_cast<std::size_t>(last - first);
+    }
+
+    [[nodiscard]] std::size_t Utf8String::calculate_char_count() const {
+        if (m_is_ascii) {
+            return m_data.size();
+        }
+        if (m_char_index != nullptr) {
+            return char_index().char_count();
         }
-        return true;
+        return detail::simd::count_chars(m_data);
     }
 
     [[nodiscard]] std::size_t Utf8String::calculate_char_width() const {
@@ -84,17 +214,23 @@ namespace c2k {
     }
 
     [[nodiscard]] Utf8String Utf8String::substring(ConstIterator const& begin, std::size_t const num_chars) const {
-        return substring(begin, begin + static_cast<ConstIterator::difference_type>(num_chars));
+        return substring(begin, advanced(begin, num_chars));
     }
 
     [[nodiscard]] Utf8String Utf8String::substring(std::size_t const start, std::size_t const num_chars) const {
-        auto const begin = this->cbegin() + static_cast<ConstIterator::difference_type>(start);
-        auto const end = begin + static_cast<ConstIterator::difference_type>(num_chars);
+        if (m_is_ascii) {
+            return from_validated_string(m_data.substr(std::min(start, m_data.size()), num_chars), true);
+        }
+        auto const begin = advanced(this->cbegin(), start);
+        auto const end = advanced(begin, num_chars);
         return substring(begin, end);
     }
 
     [[nodiscard]] Utf8String Utf8String::substring(std::size_t const start) const {
-        auto const begin = this->cbegin() + static_cast<ConstIterator::difference_type>(start);
+        if (m_is_ascii) {
+            return from_validated_string(m_data.substr(std::min(start, m_data.size())), true);
+        }
+        auto const begin = advanced(this->cbegin(), start);
         return substring(begin, this->cend());
     }
 
@@ -121,13 +257,16 @@ namespace c2k {
         if (is_empty()) {
             throw std::out_of_range{ "cannot call back() on empty string" };
         }
+        if (m_is_ascii) {
+            return Utf8Char{ m_data.back() };
+        }
         return *(cend() - 1);
     }
 
     void Utf8String::append(Utf8Char const c) {
-        for (auto const byte : c.m_codepoint) {
-            m_data.push_back(static_cast<char>(byte));
-        }
+        m_data.append(c.as_string_view());
+        m_is_ascii = m_is_ascii and c.num_bytes() == 1;
+        invalidate_char_index();
     }
 
     void Utf8String::append(char const* c_string) {
@@ -140,10 +279,14 @@ namespace c2k {
 
     void Utf8String::append(Utf8String const& string) {
         std::copy(string.m_data.cbegin(), string.m_data.cend(), std::back_inserter(m_data));
+        m_is_ascii = m_is_ascii and string.m_is_ascii;
+        invalidate_char_index();
     }
 
     void Utf8String::append(Utf8StringView const view) {
         std::copy(view.m_view.cbegin(), view.m_view.cend(), std::back_inserter(m_data));
+        m_is_ascii = m_is_ascii and (view.m_is_ascii or detail::simd::is_ascii(view.m_view));
+        invalidate_char_index();
     }
 
     Utf8String& Utf8String::operator+=(char const* c_string) {
@@ -160,15 +303,19 @@ namespace c2k {
     }
 
     [[nodiscard]] Utf8String Utf8String::operator+(Utf8Char const c) const {
-        auto copy = *this;
-        copy += c;
-        return copy;
+        auto result = Utf8String{};
+        result.reserve(num_bytes() + c.num_bytes());
+        result += *this;
+        result += c;
+        return result;
     }
 
     [[nodiscard]] Utf8String Utf8String::operator+(Utf8String const& other) const {
-        auto copy = *this;
-        copy += other;
-        return copy;
+        auto result = Utf8String{};
+        result.reserve(num_bytes() + other.num_bytes());
+        result += *this;
+        result += other;
+        return result;
     }
 
     void Utf8String::reserve(std::size_t const new_capacity_in_bytes) {
@@ -182,11 +329,7 @@ namespace c2k {
     [[nodiscard]] Utf8String::ConstIterator Utf8String::find(Utf8Char const needle, ConstIterator const& start) const {
         auto const start_offset = reinterpret_cast<char const*>(start.m_next_char_start) - m_data.data();
         auto const substring_data = std::string_view{ m_data }.substr(start_offset);
-        assert(not needle.m_codepoint.empty());
-        auto const needle_substring = std::string_view{
-            reinterpret_cast<char const*>(needle.m_codepoint.data()),
-            reinterpret_cast<char const*>(needle.m_codepoint.data() + needle.m_codepoint.size()),
-        };
+        auto const needle_substring = needle.as_string_view();
         auto const position = substring_data.find(needle_substring);
         if (position == std::string_view::npos) {
             return cend();
@@ -203,7 +346,7 @@ namespace c2k {
         Utf8Char const needle,
         ConstIterator::difference_type const start_position
     ) const { // clang-format on
-        return find(needle, cbegin() + start_position);
+        return find(needle, advanced(cbegin(), static_cast<std::size_t>(start_position)));
     }
 
     [[nodiscard]] Utf8String::ConstIterator Utf8String::find(Utf8String const& needle) const {
@@ -217,8 +360,7 @@ namespace c2k {
     ) const { // clang-format on
         auto const start_offset = reinterpret_cast<char const*>(start.m_next_char_start) - m_data.data();
         auto const substring_data = std::string_view{ m_data }.substr(start_offset);
-        auto const needle_string = std::string_view{ needle.m_data };
-        auto const position = substring_data.find(needle_string);
+        auto const position = detail::simd::find_substring(substring_data, needle.m_data);
         if (position == std::string_view::npos) {
             return cend();
         }
@@ -234,7 +376,7 @@ namespace c2k {
         Utf8String const& needle,
         ConstIterator::difference_type const start_position
     ) const { // clang-format on
-        return find(needle, cbegin() + start_position);
+        return find(needle, advanced(cbegin(), static_cast<std::size_t>(start_position)));
     }
 
     Utf8String::ConstIterator Utf8String::erase(ConstIterator const& position) {
@@ -242,12 +384,11 @@ namespace c2k {
     }
 
     Utf8String::ConstIterator Utf8String::erase(ConstIterator const& first, ConstIterator const& last) {
-        auto const start_byte_offset =
-                static_cast<std::size_t>(reinterpret_cast<char const*>(first.m_next_char_start) - m_data.data());
-        auto const end_byte_offset =
-                static_cast<std::size_t>(reinterpret_cast<char const*>(last.m_next_char_start) - m_data.data());
+        auto const start_byte_offset = byte_offset(first);
+        auto const end_byte_offset = byte_offset(last);
 
         m_data.erase(start_byte_offset, end_byte_offset - start_byte_offset);
+        invalidate_char_index();
 
         if (last == cend()) {
             return cend();
@@ -262,18 +403,62 @@ namespace c2k {
         for (auto it = crbegin(); it != crend(); ++it) {
             new_string += *it;
         }
+        auto const had_char_index = has_char_index();
         *this = std::move(new_string);
+        if (had_char_index) {
+            enable_char_index();
+        }
     }
 
     [[nodiscard]] Utf8String Utf8String::to_uppercase() const {
-        return transform([](Utf8Char const c) { return c.to_uppercase(); });
+        return from_validated_string(detail::convert_case(m_data, detail::simd::LetterCase::Upper), m_is_ascii);
     }
 
     [[nodiscard]] Utf8String Utf8String::to_lowercase() const {
-        return transform([](Utf8Char const c) { return c.to_lowercase(); });
+        return from_validated_string(detail::convert_case(m_data, detail::simd::LetterCase::Lower), m_is_ascii);
+    }
+
+    void Utf8String::make_uppercase() {
+        detail::convert_case_in_place(m_data, detail::simd::LetterCase::Upper);
+        // ASCII chars map to ASCII chars, but some non-ASCII chars do as well (e.g. the Kelvin sign)
+        m_is_ascii = m_is_ascii or detail::simd::is_ascii(m_data);
+        invalidate_char_index();
+    }
+
+    void Utf8String::make_lowercase() {
+        detail::convert_case_in_place(m_data, detail::simd::LetterCase::Lower);
+        // ASCII chars map to ASCII chars, but some non-ASCII chars do as well (e.g. the Kelvin sign)
+        m_is_ascii = m_is_ascii or detail::simd::is_ascii(m_data);
+        invalidate_char_index();
+    }
+
+    [[nodiscard]] bool Utf8String::is_normalized(NormalizationForm const form) const {
+        return Utf8StringView{ *this }.is_normalized(form);
+    }
+
+    [[nodiscard]] Utf8Normalized Utf8String::normalized(NormalizationForm const form) const& {
+        return Utf8StringView{ *this }.normalized(form);
+    }
+
+    void Utf8String::normalize(NormalizationForm const form) {
+        if (m_is_ascii) {
+            return;
+        }
+        if (auto normalized = detail::normalize_if_needed(m_data, form)) {
+            m_data = std::move(normalized).value();
+            invalidate_char_index();
+        }
+    }
+
+    [[nodiscard]] Utf8String::ConstIterator Utf8String::find(Utf8Searcher const& searcher) const {
+        return Utf8StringView{ *this }.find(searcher);
     }
 
     [[nodiscard]] std::vector<Utf8String> Utf8String::split(Utf8StringView const delimiter) const {
+        return split(Utf8Searcher{ delimiter });
+    }
+
+    [[nodiscard]] std::vector<Utf8String> Utf8String::split(Utf8Searcher const& delimiter) const {
         auto const views = Utf8StringView{ *this }.split(delimiter);
         auto result = std::vector<Utf8String>{};
         result.reserve(views.size());
@@ -283,6 +468,22 @@ namespace c2k {
         return result;
     }
 
+    [[nodiscard]] Utf8SplitView Utf8String::split_view(Utf8StringView const delimiter) const {
+        return Utf8StringView{ *this }.split_view(delimiter);
+    }
+
+    void Utf8String::split_into(Utf8StringView const delimiter, std::vector<Utf8StringView>& result) const {
+        Utf8StringView{ *this }.split_into(delimiter, result);
+    }
+
+    [[nodiscard]] Utf8TokenView Utf8String::tokenize(Utf8StringView const delimiters) const {
+        return Utf8StringView{ *this }.tokenize(delimiters);
+    }
+
+    void Utf8String::tokenize_into(Utf8StringView const delimiters, std::vector<TokenSpan>& result) const {
+        Utf8StringView{ *this }.tokenize_into(delimiters, result);
+    }
+
     [[nodiscard]] Utf8String Utf8String::replace(
             Utf8StringView const to_replace,
             Utf8StringView const replacement,
@@ -316,4 +517,72 @@ namespace c2k {
     ) const {
         return Utf8StringView{ *this }.replace(to_replace, replacement, max_num_replacements);
     }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::replace(
+        Utf8Searcher const& to_replace,
+        Utf8StringView const replacement
+    ) const { // clang-format on
+        return Utf8StringView{ *this }.replace(to_replace, replacement);
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8String::replace(
+        Utf8Searcher const& to_replace,
+        Utf8StringView const replacement,
+        MaxReplacementCount const max_num_replacements
+    ) const { // clang-format on
+        return Utf8StringView{ *this }.replace(to_replace, replacement, max_num_replacements);
+    }
+
+    [[nodiscard]] Utf8String Utf8String::from_validated_string(std::string data, bool const is_ascii) {
+        auto result = Utf8String{};
+        result.m_data = std::move(data);
+        result.m_is_ascii = is_ascii;
+        return result;
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String::ConstIterator Utf8String::advanced(
+        ConstIterator const& iterator,
+        std::size_t const num_chars
+    ) const { // clang-format on
+        if (m_is_ascii) {
+            auto const offset = byte_offset(iterator);
+            auto const target = std::min(offset + std::min(num_chars, m_data.size()), m_data.size());
+            return ConstIterator{ reinterpret_cast<std::byte const*>(m_data.data() + target) };
+        }
+        if (m_char_index != nullptr) {
+            auto const& index = char_index();
+            auto const start = index.char_index_of(m_data, byte_offset(iterator));
+            auto const target = num_chars >= index.char_count() - start ? index.char_count() : start + num_chars;
+            return ConstIterator{ reinterpret_cast<std::byte const*>(
+                    m_data.data() + index.byte_offset_of(m_data, target)
+            ) };
+        }
+        auto const bytes = reinterpret_cast<std::byte const*>(m_data.data());
+        auto position = iterator.m_next_char_start;
+        for (auto i = std::size_t{ 0 }; i < num_chars and position != bytes + m_data.size(); ++i) {
+            position += detail::utf8_sequence_length(position, bytes + m_data.size());
+        }
+        return ConstIterator{ position };
+    }
+
+    [[nodiscard]] std::size_t Utf8String::byte_offset(ConstIterator const& iterator) const {
+        return static_cast<std::size_t>(reinterpret_cast<char const*>(iterator.m_next_char_start) - m_data.data());
+    }
+
+    [[nodiscard]] detail::Utf8CharIndex const& Utf8String::char_index() const {
+        assert(m_char_index != nullptr);
+        m_char_index->build_once(m_data);
+        return *m_char_index;
+    }
+
+    void Utf8String::invalidate_char_index() {
+        // an index that has not been built yet can still be used (unless it's shared with another string)
+        if (m_char_index == nullptr or (not m_char_index->is_built() and m_char_index.use_count() == 1)) {
+            return;
+        }
+        m_char_index = std::make_shared<detail::Utf8CharIndex>(char_index_stride);
+    }
 } // namespace c2k
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <lib2k/utf8/string.hpp>
+#include <lib2k/utf8/string_builder.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace c2k {
+    void Utf8StringBuilder::reserve(std::size_t const num_bytes) {
+        if (free_space().size() < num_bytes) {
+            start_chunk(num_bytes);
+        }
+    }
+
+    void Utf8StringBuilder::clear() {
+        m_inline_size = 0;
+        for (auto i = std::size_t{ 0 }; i < m_num_used_chunks; ++i) {
+            m_chunks[i].size = 0;
+        }
+        m_num_used_chunks = 0;
+        m_num_bytes = 0;
+        m_is_ascii = true;
+    }
+
+    void Utf8StringBuilder::append(Utf8Char const c) {
+        auto const bytes = c.as_string_view();
+        append_bytes(bytes);
+        m_is_ascii = m_is_ascii and bytes.size() == 1;
+    }
+
+    void Utf8StringBuilder::append(Utf8StringView const view) {
+        append_bytes(view.view());
+        m_is_ascii = m_is_ascii and view.is_ascii();
+    }
+
+    void Utf8StringBuilder::append(Utf8String const& string) {
+        append_bytes(string.view());
+        m_is_ascii = m_is_ascii and string.is_ascii();
+    }
+
+    Utf8StringBuilder& Utf8StringBuilder::operator+=(Utf8StringView const view) {
+        append(view);
+        return *this;
+    }
+
+    [[nodiscard]] Utf8String Utf8StringBuilder::finish() const {
+        auto data = std::string{};
+        // the second argument of the operation may be the capacity (instead of the requested size)
+        data.resize_and_overwrite(m_num_bytes, [this](char* const destination, std::size_t) {
+            copy_to(destination);
+            return m_num_bytes;
+        });
+        return Utf8String::from_validated_string(std::move(data), m_is_ascii);
+    }
+
+    [[nodiscard]] Utf8StringView Utf8StringBuilder::finish_into(std::span<char> const buffer) const {
+        if (buffer.size() < m_num_bytes) {
+            throw std::invalid_argument{ "buffer is too small for the built string" };
+        }
+        copy_to(buffer.data());
+        auto result = Utf8StringView::from_string_view_unchecked(std::string_view{ buffer.data(), m_num_bytes });
+        result.m_is_ascii = m_is_ascii;
+        return result;
+    }
+
+    // Fills up the current chunk before starting a new one.
+    void Utf8StringBuilder::append_bytes(std::string_view bytes) {
+        while (true) {
+            auto const space = free_space();
+            auto const num_copied = std::min(space.size(), bytes.size());
+            std::copy_n(bytes.data(), num_copied, space.data());
+            commit(num_copied);
+            bytes.remove_prefix(num_copied);
+            if (bytes.empty()) {
+                return;
+            }
+            start_chunk(bytes.size());
+        }
+    }
+
+    [[nodiscard]] std::span<char> Utf8StringBuilder::free_space() {
+        if (m_num_used_chunks == 0) {
+            return std::span{ m_inline }.subspan(m_inline_size);
+        }
+        auto& chunk = m_chunks[m_num_used_chunks - 1];
+        return std::span{ chunk.data.get() + chunk.size, chunk.capacity - chunk.size };
+    }
+
+    [[nodiscard]] std::span<char> Utf8StringBuilder::contiguous_space(std::size_t const num_bytes) {
+        reserve(num_bytes);
+        return free_space();
+    }
+
+    void Utf8StringBuilder::commit(std::size_t const num_bytes) {
+        if (m_num_used_chunks == 0) {
+            m_inline_size += num_bytes;
+        } else {
+            m_chunks[m_num_used_chunks - 1].size += num_bytes;
+        }
+        m_num_bytes += num_bytes;
+    }
+
+    void Utf8StringBuilder::start_chunk(std::size_t const min_capacity) {
+        if (m_num_used_chunks < m_chunks.size()) {
+            auto& chunk = m_chunks[m_num_used_chunks];
+            if (chunk.capacity < min_capacity) {
+                chunk.data = std::make_unique_for_overwrite<char[]>(min_capacity);
+                chunk.capacity = min_capacity;
+            }
+            chunk.size = 0;
+        } else {
+            auto const previous_capacity = m_chunks.empty() ? inline_capacity : m_chunks.back().capacity;
+            auto const capacity = std::max(min_capacity, std::min(2 * previous_capacity, max_chunk_growth));
+            m_chunks.push_back(Chunk{ std::make_unique_for_overwrite<char[]>(capacity), capacity, 0 });
+        }
+        ++m_num_used_chunks;
+    }
+
+    void Utf8StringBuilder::copy_to(char* destination) const {
+        destination = std::copy_n(m_inline.data(), m_inline_size, destination);
+        for (auto i = std::size_t{ 0 }; i < m_num_used_chunks; ++i) {
+            destination = std::copy_n(m_chunks[i].data.get(), m_chunks[i].size, destination);
+        }
+    }
+} // namespace c2k
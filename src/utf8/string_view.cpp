@@ -1,27 +1,34 @@
+#include "../simd/simd.hpp"
+#include "case_mapping.hpp"
+#include "char_width.hpp"
+#include "normalizer.hpp"
+#include "replace.hpp"
+#include <lib2k/utf8/searcher.hpp>
 #include <lib2k/utf8/string.hpp>
 #include <lib2k/utf8/string_view.hpp>
-#include <utf8proc.h>
+#include <algorithm>
 
 namespace c2k {
 
-    Utf8StringView::Utf8StringView(Utf8String const& string) : m_view{ string.m_data } { }
+    Utf8StringView::Utf8StringView(Utf8String const& string)
+        : m_view{ string.m_data },
+          m_is_ascii{ string.m_is_ascii } { }
 
-    Utf8StringView::Utf8StringView(std::string const& string) {
-        if (not Utf8String::is_valid_utf8(string)) {
-            throw InvalidUtf8String{};
-        }
-        *this = from_string_view_unchecked(string);
-    }
+    Utf8StringView::Utf8StringView(std::string const& string) : Utf8StringView{ std::string_view{ string } } { }
 
+    // The ASCII property is unknown here and determining it would make this constructor O(n).
     Utf8StringView::Utf8StringView(detail::Utf8ConstIterator const& begin, detail::Utf8ConstIterator const& end)
         : m_view{ reinterpret_cast<char const*>(begin.m_next_char_start),
-                  reinterpret_cast<char const*>(end.m_next_char_start) } { }
+                  reinterpret_cast<char const*>(end.m_next_char_start) },
+          m_is_ascii{ false } { }
 
     Utf8StringView::Utf8StringView(std::string_view const view) {
-        if (not Utf8String::is_valid_utf8(view)) {
+        auto const validation = detail::simd::validate_utf8(view);
+        if (not validation.is_valid) {
             throw InvalidUtf8String{};
         }
-        *this = from_string_view_unchecked(view);
+        m_view = view;
+        m_is_ascii = validation.is_ascii;
     }
 
     Utf8StringView::Utf8StringView(char const* const chars) : Utf8StringView{ std::string_view{ chars } } {
@@ -33,37 +40,58 @@ namespace c2k {
     [[nodiscard]] Utf8StringView Utf8StringView::from_string_view_unchecked(std::string_view const view) {
         auto result = Utf8StringView{};
         result.m_view = view;
+        result.m_is_ascii = false;
         return result;
     }
 
+    [[nodiscard]] bool Utf8StringView::is_ascii() const {
+        return m_is_ascii or detail::simd::is_ascii(m_view);
+    }
+
+    [[nodiscard]] std::size_t Utf8StringView::calculate_char_count() const {
+        if (m_is_ascii) {
+            return m_view.size();
+        }
+        return detail::simd::count_chars(m_view);
+    }
+
     [[nodiscard]] std::size_t Utf8StringView::calculate_char_width() const {
-        auto width = std::size_t{ 0 };
-        auto current = reinterpret_cast<utf8proc_uint8_t const*>(m_view.data());
-
-        while (current < reinterpret_cast<utf8proc_uint8_t const*>(m_view.data() + m_view.length())) {
-            auto codepoint = utf8proc_int32_t{};
-            auto const bytes_read = utf8proc_iterate(current, -1, &codepoint);
-            // clang-format off
-            assert(
-                codepoint != -1
-                and utf8proc_codepoint_valid(codepoint)
-                and "Utf8String objects must always contain valid UTF8"
-            );
-            // clang-format on
-            width += static_cast<std::size_t>(utf8proc_charwidth(codepoint));
-            current += bytes_read;
+        if (m_is_ascii) {
+            return detail::simd::measure_ascii_width(m_view).width;
         }
-        // clang-format off
-        assert(
-            current == reinterpret_cast<utf8proc_uint8_t const*>(m_view.data() + m_view.length())
-            and "Utf8String objects must always contain valid UTF8"
-        );
-        // clang-format on
-        return width;
+        return detail::calculate_char_width(m_view);
+    }
+
+    [[nodiscard]] bool Utf8StringView::equals_ignore_case(Utf8StringView const other) const {
+        if (m_is_ascii and other.m_is_ascii) {
+            return m_view.size() == other.m_view.size()
+                   and detail::simd::ascii_common_prefix_ignore_case(m_view, other.m_view) == m_view.size();
+        }
+        return detail::equals_ignore_case(m_view, other.m_view);
+    }
+
+    [[nodiscard]] std::weak_ordering Utf8StringView::compare_ignore_case(Utf8StringView const other) const {
+        return detail::compare_ignore_case(m_view, other.m_view);
+    }
+
+    [[nodiscard]] bool Utf8StringView::is_normalized(NormalizationForm const form) const {
+        return m_is_ascii or detail::is_normalized(m_view, form);
+    }
+
+    [[nodiscard]] Utf8Normalized Utf8StringView::normalized(NormalizationForm const form) const {
+        if (m_is_ascii) {
+            return Utf8Normalized{ m_view };
+        }
+        if (auto normalized = detail::normalize_if_needed(m_view, form)) {
+            return Utf8Normalized{ std::move(normalized).value() };
+        }
+        return Utf8Normalized{ m_view };
     }
 
     [[nodiscard]] Utf8StringView Utf8StringView::substring(ConstIterator const begin, ConstIterator const end) const {
-        return Utf8StringView{ begin, end };
+        auto result = Utf8StringView{ begin, end };
+        result.m_is_ascii = m_is_ascii;
+        return result;
     }
 
     [[nodiscard]] Utf8StringView Utf8StringView::substring(ConstIterator const begin) const {
@@ -75,17 +103,27 @@ namespace c2k {
         ConstIterator const begin,
         std::size_t const num_chars
     ) const { // clang-format on
-        return substring(begin, begin + static_cast<ConstIterator::difference_type>(num_chars));
+        return substring(begin, advanced(begin, num_chars));
     }
 
     [[nodiscard]] Utf8StringView Utf8StringView::substring(std::size_t const start, std::size_t const num_chars) const {
-        auto const begin = this->cbegin() + static_cast<ConstIterator::difference_type>(start);
-        auto const end = begin + static_cast<ConstIterator::difference_type>(num_chars);
+        if (m_is_ascii) {
+            auto result = from_string_view_unchecked(m_view.substr(std::min(start, m_view.size()), num_chars));
+            result.m_is_ascii = true;
+            return result;
+        }
+        auto const begin = advanced(this->cbegin(), start);
+        auto const end = advanced(begin, num_chars);
         return substring(begin, end);
     }
 
     [[nodiscard]] Utf8StringView Utf8StringView::substring(std::size_t const start) const {
-        auto const begin = this->cbegin() + static_cast<ConstIterator::difference_type>(start);
+        if (m_is_ascii) {
+            auto result = from_string_view_unchecked(m_view.substr(std::min(start, m_view.size())));
+            result.m_is_ascii = true;
+            return result;
+        }
+        auto const begin = advanced(this->cbegin(), start);
         return substring(begin, this->cend());
     }
 
@@ -100,6 +138,9 @@ namespace c2k {
         if (is_empty()) {
             throw std::out_of_range{ "cannot call back() on empty string view" };
         }
+        if (m_is_ascii) {
+            return Utf8Char{ m_view.back() };
+        }
         return *(cend() - 1);
     }
 
@@ -114,11 +155,7 @@ namespace c2k {
     ) const { // clang-format on
         auto const start_offset = reinterpret_cast<char const*>(start.m_next_char_start) - m_view.data();
         auto const substring_data = m_view.substr(start_offset);
-        assert(not needle.m_codepoint.empty());
-        auto const needle_substring = std::string_view{
-            reinterpret_cast<char const*>(needle.m_codepoint.data()),
-            reinterpret_cast<char const*>(needle.m_codepoint.data() + needle.m_codepoint.size()),
-        };
+        auto const needle_substring = needle.as_string_view();
         auto const position = substring_data.find(needle_substring);
         if (position == std::string_view::npos) {
             return cend();
@@ -135,7 +172,7 @@ namespace c2k {
         Utf8Char const needle,
         ConstIterator::difference_type const start_position
     ) const { // clang-format on
-        return find(needle, cbegin() + start_position);
+        return find(needle, advanced(cbegin(), static_cast<std::size_t>(start_position)));
     }
 
     [[nodiscard]] Utf8StringView::ConstIterator Utf8StringView::find(Utf8StringView const needle) const {
@@ -149,8 +186,7 @@ namespace c2k {
     ) const { // clang-format on
         auto const start_offset = reinterpret_cast<char const*>(start.m_next_char_start) - m_view.data();
         auto const substring_data = m_view.substr(start_offset);
-        auto const needle_string = std::string_view{ needle.m_view };
-        auto const position = substring_data.find(needle_string);
+        auto const position = detail::simd::find_substring(substring_data, needle.m_view);
         if (position == std::string_view::npos) {
             return cend();
         }
@@ -166,91 +202,190 @@ namespace c2k {
         Utf8StringView const needle,
         ConstIterator::difference_type const start_position
     ) const { // clang-format on
-        return find(needle, cbegin() + start_position);
+        return find(needle, advanced(cbegin(), static_cast<std::size_t>(start_position)));
     }
 
-    [[nodiscard]] std::vector<Utf8StringView> Utf8StringView::split(Utf8StringView const delimiter) const {
-        if (delimiter.is_empty()) {
-            throw std::invalid_argument{ "cannot split string with empty delimiter" };
-        }
+    [[nodiscard]] Utf8StringView::ConstIterator Utf8StringView::find(Utf8Searcher const& searcher) const {
+        return find(searcher, cbegin());
+    }
 
-        auto find_iterator = find(delimiter);
-        if (find_iterator == cend()) {
-            return { *this };
+    // clang-format off
+    [[nodiscard]] Utf8StringView::ConstIterator Utf8StringView::find(
+        Utf8Searcher const& searcher,
+        ConstIterator const& start
+    ) const { // clang-format on
+        auto const start_offset = reinterpret_cast<char const*>(start.m_next_char_start) - m_view.data();
+        auto const position = searcher.find_in(m_view, static_cast<std::size_t>(start_offset));
+        if (position == std::string_view::npos) {
+            return cend();
         }
+        return ConstIterator{ reinterpret_cast<std::byte const*>(m_view.data() + position) };
+    }
 
-        auto const delimiter_char_count = delimiter.calculate_char_count();
+    [[nodiscard]] Utf8String Utf8StringView::to_uppercase() const {
+        return Utf8String::from_validated_string(
+                detail::convert_case(m_view, detail::simd::LetterCase::Upper),
+                m_is_ascii
+        );
+    }
+
+    [[nodiscard]] Utf8String Utf8StringView::to_lowercase() const {
+        return Utf8String::from_validated_string(
+                detail::convert_case(m_view, detail::simd::LetterCase::Lower),
+                m_is_ascii
+        );
+    }
+
+    [[nodiscard]] std::vector<Utf8StringView> Utf8StringView::split(Utf8StringView const delimiter) const {
+        return split(Utf8Searcher{ delimiter });
+    }
 
+    [[nodiscard]] std::vector<Utf8StringView> Utf8StringView::split(Utf8Searcher const& delimiter) const {
         auto result = std::vector<Utf8StringView>{};
-        decltype(find_iterator) last_iterator = cbegin();
-        while (find_iterator != cend()) {
-            result.push_back(substring(last_iterator, find_iterator));
-            last_iterator = find_iterator + static_cast<ConstIterator::difference_type>(delimiter_char_count);
-            find_iterator = find(delimiter, last_iterator);
-        }
-        result.push_back(substring(last_iterator));
+        detail::split_into(*this, delimiter, result);
         return result;
     }
 
-    [[nodiscard]] Utf8String Utf8StringView::replace(
-            Utf8StringView const to_replace,
-            Utf8StringView const replacement,
-            ConstIterator const& start,
-            MaxReplacementCount const max_num_replacements
-    ) const {
-        if (std::to_underlying(max_num_replacements) == 0) {
-            return *this;
+    // clang-format off
+    [[nodiscard]] std::pmr::vector<Utf8StringView> Utf8StringView::split(
+        Utf8StringView const delimiter,
+        std::pmr::memory_resource* const resource
+    ) const { // clang-format on
+        auto result = std::pmr::vector<Utf8StringView>{ resource };
+        detail::split_into(*this, Utf8Searcher{ delimiter }, result);
+        return result;
+    }
+
+    [[nodiscard]] Utf8SplitView Utf8StringView::split_view(Utf8StringView const delimiter) const {
+        return Utf8SplitView{ m_view, delimiter.m_view };
+    }
+
+    void Utf8StringView::split_into(Utf8StringView const delimiter, std::vector<Utf8StringView>& result) const {
+        split_into(Utf8Searcher{ delimiter }, result);
+    }
+
+    void Utf8StringView::split_into(Utf8Searcher const& delimiter, std::vector<Utf8StringView>& result) const {
+        result.clear();
+        detail::split_into(*this, delimiter, result);
+    }
+
+    [[nodiscard]] Utf8TokenView Utf8StringView::tokenize(Utf8StringView const delimiters) const {
+        auto lead_bytes = ByteSet{};
+        for (auto const char_span : delimiters.char_spans()) {
+            lead_bytes.insert(static_cast<char>(char_span.front()));
         }
+        return Utf8TokenView{ m_view, detail::Utf8CharDelimiters{ lead_bytes, delimiters.m_view } };
+    }
 
-        if (start == cend()) {
-            if (to_replace.is_empty()) {
-                return replacement;
+    void Utf8StringView::tokenize_into(Utf8StringView const delimiters, std::vector<TokenSpan>& result) const {
+        tokenize(delimiters).spans_into(result);
+    }
+
+    namespace detail {
+        [[nodiscard]] Utf8StringView Utf8CharDelimiters::make_token(std::string_view const token) {
+            return Utf8StringView::from_string_view_unchecked(token);
+        }
+
+        // clang-format off
+        [[nodiscard]] std::size_t Utf8CharDelimiters::match_length(
+            std::string_view const s,
+            std::size_t const position
+        ) const { // clang-format on
+            if (not lead_bytes.contains(s[position])) {
+                return 0;
             }
-            return *this;
+            auto const rest = s.substr(position);
+            for (auto const char_span : Utf8StringView::from_string_view_unchecked(chars).char_spans()) {
+                auto const delimiter_data = reinterpret_cast<char const*>(char_span.data());
+                auto const delimiter = std::string_view{ delimiter_data, char_span.size() };
+                if (rest.starts_with(delimiter)) {
+                    return delimiter.size();
+                }
+            }
+            return 0;
         }
 
-        if (to_replace.is_empty()) {
-            auto result = Utf8String{};
-            result += replacement;
-            for (auto const c : *this) {
-                result += c;
-                result += replacement;
+        [[nodiscard]] std::size_t Utf8CharDelimiters::find(std::string_view const s, std::size_t const start) const {
+            auto position = find_first_in_set(s, start, lead_bytes);
+            // a lead byte may be shared by different chars, of which only some are delimiters
+            while (position != std::string_view::npos and match_length(s, position) == 0) {
+                position = find_first_in_set(s, position + 1, lead_bytes);
             }
-            return result;
+            return position;
         }
 
-        auto current = find(to_replace, start);
-        if (current == cend()) {
-            return *this;
+        [[nodiscard]] Utf8StringView Utf8SplitTraits::make_part(std::string_view const part) {
+            return Utf8StringView::from_string_view_unchecked(part);
         }
-        auto result = Utf8String{};
-        auto num_replacements = std::underlying_type_t<decltype(max_num_replacements)>{ 0 };
-        auto previous = cbegin();
-        while (current != cend()) {
-            if (current != previous) {
-                result += Utf8StringView{ previous, current };
-            }
-            result += replacement;
-            ++num_replacements;
-            current += static_cast<ConstIterator::difference_type>(to_replace.calculate_char_count());
-            previous = current;
-            if (current == cend()) {
-                break;
-            }
-            if (num_replacements >= std::to_underlying(max_num_replacements)) {
-                result += Utf8StringView{ current, cend() };
-                break;
-            }
-            current = find(to_replace, current);
-            if (current == cend()) {
-                result += Utf8StringView{ previous, cend() };
-                break;
-            }
+
+        // clang-format off
+        [[nodiscard]] std::size_t Utf8SplitTraits::find(
+            std::string_view const haystack,
+            std::string_view const needle,
+            std::size_t const start
+        ) { // clang-format on
+            auto const position = simd::find_substring(haystack.substr(start), needle);
+            return position == std::string_view::npos ? position : start + position;
         }
-        if (current != cend() and num_replacements < std::to_underlying(max_num_replacements)) {
-            result += Utf8StringView{ current, cend() };
+    } // namespace detail
+
+    [[nodiscard]] Utf8String Utf8StringView::replace(
+            Utf8StringView const to_replace,
+            Utf8StringView const replacement,
+            ConstIterator const& start,
+            MaxReplacementCount const max_num_replacements
+    ) const {
+        auto result = std::string{};
+        auto const start_offset = Utf8StringView{ cbegin(), start }.num_bytes();
+        auto const searcher = Utf8Searcher{ to_replace };
+        detail::write_replaced(*this, searcher, replacement, start_offset, max_num_replacements, result);
+        return Utf8String::from_validated_string(std::move(result), m_is_ascii and replacement.m_is_ascii);
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8StringView::replace(
+        Utf8Searcher const& to_replace,
+        Utf8StringView const replacement
+    ) const { // clang-format on
+        return replace(
+                to_replace,
+                replacement,
+                MaxReplacementCount{ std::numeric_limits<std::underlying_type_t<MaxReplacementCount>>::max() }
+        );
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8String Utf8StringView::replace(
+        Utf8Searcher const& to_replace,
+        Utf8StringView const replacement,
+        MaxReplacementCount const max_num_replacements
+    ) const { // clang-format on
+        auto result = std::string{};
+        detail::write_replaced(*this, to_replace, replacement, 0, max_num_replacements, result);
+        return Utf8String::from_validated_string(std::move(result), m_is_ascii and replacement.m_is_ascii);
+    }
+
+    // clang-format off
+    [[nodiscard]] Utf8StringView::ConstIterator Utf8StringView::advanced(
+        ConstIterator const& iterator,
+        std::size_t const num_chars
+    ) const { // clang-format on
+        if (m_is_ascii) {
+            auto const offset = static_cast<std::size_t>(
+                    reinterpret_cast<char const*>(iterator.m_next_char_start) - m_view.data()
+            );
+            auto const target = std::min(offset + std::min(num_chars, m_view.size()), m_view.size());
+            return ConstIterator{ reinterpret_cast<std::byte const*>(m_view.data() + target) };
         }
+        auto const bytes = reinterpret_cast<std::byte const*>(m_view.data());
+        auto position = iterator.m_next_char_start;
+        for (auto i = std::size_t{ 0 }; i < num_chars and position != bytes + m_view.size(); ++i) {
+            position += detail::utf8_sequence_length(position, bytes + m_view.size());
+        }
+        return ConstIterator{ position };
+    }
 
-        return result;
+    [[nodiscard]] std::size_t CaseInsensitiveHash::operator()(Utf8StringView const view) const {
+        return detail::hash_ignore_case(view.view());
     }
 } // namespace c2k
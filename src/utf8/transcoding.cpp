@@ -0,0 +1,239 @@
+#include "../simd/simd.hpp"
+#include <lib2k/utf8/ranges.hpp>
+#include <lib2k/utf8/string.hpp>
+#include <lib2k/utf8/string_view.hpp>
+#include <lib2k/utf8/transcoding.hpp>
+#include <optional>
+#include <stdexcept>
+
+namespace c2k {
+    namespace {
+        struct DecodedCodepoint final {
+            char32_t codepoint;
+            std::size_t num_code_units;
+        };
+
+        [[nodiscard]] bool is_high_surrogate(char32_t const code_unit) {
+            return code_unit >= 0xD800 and code_unit <= 0xDBFF;
+        }
+
+        [[nodiscard]] bool is_low_surrogate(char32_t const code_unit) {
+            return code_unit >= 0xDC00 and code_unit <= 0xDFFF;
+        }
+
+        // clang-format off
+        [[nodiscard]] std::optional<DecodedCodepoint> decode(
+            std::u16string_view const source,
+            std::size_t const position
+        ) { // clang-format on
+            auto const first = static_cast<char32_t>(source[position]);
+            if (is_low_surrogate(first)) {
+                return std::nullopt;
+            }
+            if (not is_high_surrogate(first)) {
+                return DecodedCodepoint{ first, 1 };
+            }
+            if (position + 1 == source.size() or not is_low_surrogate(source[position + 1])) {
+                return std::nullopt;
+            }
+            auto const second = static_cast<char32_t>(source[position + 1]);
+            return DecodedCodepoint{ 0x1'0000 + ((first - 0xD800) << 10) + (second - 0xDC00), 2 };
+        }
+
+        // clang-format off
+        [[nodiscard]] std::optional<DecodedCodepoint> decode(
+            std::u32string_view const source,
+            std::size_t const position
+        ) { // clang-format on
+            auto const codepoint = source[position];
+            if (codepoint > 0x10'FFFF or is_high_surrogate(codepoint) or is_low_surrogate(codepoint)) {
+                return std::nullopt;
+            }
+            return DecodedCodepoint{ codepoint, 1 };
+        }
+
+        [[nodiscard]] std::size_t utf8_sequence_length(char32_t const codepoint) {
+            if (codepoint < 0x80) {
+                return 1;
+            }
+            if (codepoint < 0x800) {
+                return 2;
+            }
+            return codepoint < 0x1'0000 ? 3 : 4;
+        }
+
+        template<typename CodeUnit>
+        [[nodiscard]] Utf8Error invalid_input_error() {
+            return std::same_as<CodeUnit, char16_t> ? Utf8Error::InvalidUtf16String : Utf8Error::InvalidUtf32String;
+        }
+
+        template<typename CodeUnit>
+        // clang-format off
+        [[nodiscard]] tl::expected<std::size_t, Utf8Error> calculate_utf8_length(
+            std::basic_string_view<CodeUnit> const source
+        ) { // clang-format on
+            auto result = std::size_t{ 0 };
+            auto position = std::size_t{ 0 };
+            while (position < source.size()) {
+                if (source[position] < 0x80) {
+                    ++result;
+                    ++position;
+                    continue;
+                }
+                auto const decoded = decode(source, position);
+                if (not decoded.has_value()) {
+                    return tl::unexpected{ invalid_input_error<CodeUnit>() };
+                }
+                result += utf8_sequence_length(decoded->codepoint);
+                position += decoded->num_code_units;
+            }
+            return result;
+        }
+
+        template<typename CodeUnit>
+        // clang-format off
+        [[nodiscard]] tl::expected<std::size_t, Utf8Error> transcode_to_utf8(
+            std::basic_string_view<CodeUnit> const source,
+            std::span<char> const destination
+        ) { // clang-format on
+            auto written = std::size_t{ 0 };
+            auto position = std::size_t{ 0 };
+            while (position < source.size()) {
+                auto const remaining = source.substr(position, destination.size() - written);
+                auto const num_ascii = detail::simd::narrow_ascii(remaining, destination.data() + written);
+                written += num_ascii;
+                position += num_ascii;
+                if (position == source.size()) {
+                    break;
+                }
+                if (source[position] < 0x80) {
+                    throw std::length_error{ "destination is too small" };
+                }
+
+                // decode the following non-ASCII code points without calling the kernel in between
+                while (position < source.size() and source[position] >= 0x80) {
+                    auto const decoded = decode(source, position);
+                    if (not decoded.has_value()) {
+                        return tl::unexpected{ invalid_input_error<CodeUnit>() };
+                    }
+                    if (utf8_sequence_length(decoded->codepoint) > destination.size() - written) {
+                        throw std::length_error{ "destination is too small" };
+                    }
+                    written += detail::encode_utf8(
+                            decoded->codepoint,
+                            reinterpret_cast<std::byte*>(destination.data() + written)
+                    );
+                    position += decoded->num_code_units;
+                }
+            }
+            return written;
+        }
+
+        template<typename CodeUnit>
+        // clang-format off
+        [[nodiscard]] std::size_t transcode_from_utf8(
+            Utf8StringView const source,
+            std::span<CodeUnit> const destination
+        ) { // clang-format on
+            auto const view = source.view();
+            auto const bytes = reinterpret_cast<std::byte const*>(view.data());
+            auto written = std::size_t{ 0 };
+            auto position = std::size_t{ 0 };
+            while (position < view.size()) {
+                // the length of the destination has been checked up front
+                auto const num_ascii = detail::simd::widen_ascii(view.substr(position), destination.data() + written);
+                written += num_ascii;
+                position += num_ascii;
+
+                while (position < view.size() and static_cast<std::uint8_t>(bytes[position]) >= 0x80) {
+                    auto const num_bytes = detail::utf8_sequence_length(bytes + position, bytes + view.size());
+                    auto const codepoint = detail::decode_utf8(bytes + position, num_bytes);
+                    position += num_bytes;
+                    if (std::same_as<CodeUnit, char16_t> and codepoint >= 0x1'0000) {
+                        destination[written] = static_cast<CodeUnit>(0xD800 + ((codepoint - 0x1'0000) >> 10));
+                        destination[written + 1] = static_cast<CodeUnit>(0xDC00 + ((codepoint - 0x1'0000) & 0x3FF));
+                        written += 2;
+                    } else {
+                        destination[written] = static_cast<CodeUnit>(codepoint);
+                        ++written;
+                    }
+                }
+            }
+            return written;
+        }
+    } // namespace
+
+    [[nodiscard]] std::size_t utf16_length(Utf8StringView const source) {
+        return detail::simd::count_utf16_code_units(source.view());
+    }
+
+    [[nodiscard]] std::size_t utf32_length(Utf8StringView const source) {
+        return source.calculate_char_count();
+    }
+
+    [[nodiscard]] std::size_t transcode_to_utf16(Utf8StringView const source, std::span<char16_t> const destination) {
+        if (utf16_length(source) > destination.size()) {
+            throw std::length_error{ "destination is too small" };
+        }
+        return transcode_from_utf8(source, destination);
+    }
+
+    [[nodiscard]] std::u16string transcode_to_utf16(Utf8StringView const source) {
+        auto result = std::u16string(utf16_length(source), u'\0');
+        std::ignore = transcode_from_utf8(source, std::span{ result });
+        return result;
+    }
+
+    [[nodiscard]] std::size_t transcode_to_utf32(Utf8StringView const source, std::span<char32_t> const destination) {
+        if (utf32_length(source) > destination.size()) {
+            throw std::length_error{ "destination is too small" };
+        }
+        return transcode_from_utf8(source, destination);
+    }
+
+    [[nodiscard]] std::u32string transcode_to_utf32(Utf8StringView const source) {
+        auto result = std::u32string(utf32_length(source), U'\0');
+        std::ignore = transcode_from_utf8(source, std::span{ result });
+        return result;
+    }
+
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> utf8_length(std::u16string_view const source) {
+        return calculate_utf8_length(source);
+    }
+
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> utf8_length(std::u32string_view const source) {
+        return calculate_utf8_length(source);
+    }
+
+    // clang-format off
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> transcode_from_utf16(
+        std::u16string_view const source,
+        std::span<char> const destination
+    ) { // clang-format on
+        return transcode_to_utf8(source, destination);
+    }
+
+    [[nodiscard]] tl::expected<Utf8String, Utf8Error> transcode_from_utf16(std::u16string_view const source) {
+        return utf8_length(source).map([&](std::size_t const length) {
+            auto result = std::string(length, '\0');
+            std::ignore = transcode_to_utf8(source, std::span{ result });
+            return Utf8String::from_validated_string(std::move(result), length == source.size());
+        });
+    }
+
+    // clang-format off
+    [[nodiscard]] tl::expected<std::size_t, Utf8Error> transcode_from_utf32(
+        std::u32string_view const source,
+        std::span<char> const destination
+    ) { // clang-format on
+        return transcode_to_utf8(source, destination);
+    }
+
+    [[nodiscard]] tl::expected<Utf8String, Utf8Error> transcode_from_utf32(std::u32string_view const source) {
+        return utf8_length(source).map([&](std::size_t const length) {
+            auto result = std::string(length, '\0');
+            std::ignore = transcode_to_utf8(source, std::span{ result });
+            return Utf8String::from_validated_string(std::move(result), length == source.size());
+        });
+    }
+} // namespace c2k
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace c2k::detail {
+    enum class Utf8SequenceStatus {
+        Valid,
+        Invalid,
+        // the bytes form a valid prefix of a sequence, but the input ends before the sequence is complete
+        Truncated,
+    };
+
+    struct Utf8Sequence final {
+        std::size_t length;
+        Utf8SequenceStatus status;
+    };
+
+    // Inspects the sequence at the start of `bytes` (see table 3-7 of the Unicode standard). For ill-formed
+    // sequences, `length` is the length of the maximal ill-formed subpart (which is at most 3 bytes long).
+    // clang-format off
+    [[nodiscard]] inline Utf8Sequence inspect_utf8_sequence(
+        unsigned char const* const bytes,
+        std::size_t const remaining
+    ) { // clang-format on
+        auto const lead = bytes[0];
+        if (lead < 0x80) {
+            return Utf8Sequence{ 1, Utf8SequenceStatus::Valid };
+        }
+        auto length = std::size_t{ 0 };
+        auto lower = std::uint8_t{ 0x80 };
+        auto upper = std::uint8_t{ 0xBF };
+        if (lead >= 0xC2 and lead <= 0xDF) {
+            length = 2;
+        } else if (lead >= 0xE0 and lead <= 0xEF) {
+            length = 3;
+            lower = (lead == 0xE0 ? 0xA0 : 0x80);
+            upper = (lead == 0xED ? 0x9F : 0xBF);
+        } else if (lead >= 0xF0 and lead <= 0xF4) {
+            length = 4;
+            lower = (lead == 0xF0 ? 0x90 : 0x80);
+            upper = (lead == 0xF4 ? 0x8F : 0xBF);
+        } else {
+            return Utf8Sequence{ 1, Utf8SequenceStatus::Invalid };
+        }
+        for (auto i = std::size_t{ 1 }; i < length; ++i) {
+            if (i == remaining) {
+                return Utf8Sequence{ i, Utf8SequenceStatus::Truncated };
+            }
+            if (bytes[i] < lower or bytes[i] > upper) {
+                return Utf8Sequence{ i, Utf8SequenceStatus::Invalid };
+            }
+            lower = 0x80;
+            upper = 0xBF;
+        }
+        return Utf8Sequence{ length, Utf8SequenceStatus::Valid };
+    }
+} // namespace c2k::detail
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+#include <lib2k/multi_pattern_matcher.hpp>
+#include <lib2k/string_utils.hpp>
+#include <lib2k/utf8.hpp>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using c2k::MultiPatternMatcher;
+using c2k::PatternMatch;
+using namespace c2k::Utf8Literals;
+
+TEST(MultiPatternMatcherTests, FindAll) {
+    auto const matcher = MultiPatternMatcher{ std::vector<std::string>{ "he", "she", "his", "hers" } };
+    EXPECT_EQ(matcher.num_patterns(), 4);
+    EXPECT_EQ(matcher.pattern(1), "she");
+
+    // "she" starts before "he" and "hers"
+    auto const expected = std::vector<PatternMatch>{
+        PatternMatch{ 1, 1, 3 },
+        PatternMatch{ 2, 7, 3 },
+    };
+    EXPECT_EQ(matcher.find_all("ushers his"), expected);
+    EXPECT_EQ(matcher.find_all("hers"), (std::vector<PatternMatch>{ PatternMatch{ 3, 0, 4 } }));
+    EXPECT_TRUE(matcher.find_all("").empty());
+    EXPECT_TRUE(matcher.find_all("nothing to see").empty());
+
+    EXPECT_TRUE(matcher.contains_any("ushers"));
+    EXPECT_TRUE(matcher.contains_any("this"));
+    EXPECT_FALSE(matcher.contains_any("nothing to see"));
+    EXPECT_FALSE(matcher.contains_any(""));
+
+    auto const with_empty_pattern = std::vector<std::string>{ "a", "" };
+    EXPECT_THROW(std::ignore = MultiPatternMatcher{ with_empty_pattern }, std::invalid_argument);
+}
+
+TEST(MultiPatternMatcherTests, LeftmostLongestMatches) {
+    auto const matcher = MultiPatternMatcher{ std::vector<std::string>{ "bc", "abcd", "ab", "cde", "cdef" } };
+    // "abcd" starts before "bc" although "bc" ends first
+    EXPECT_EQ(matcher.find_all("abcd"), (std::vector<PatternMatch>{ PatternMatch{ 1, 0, 4 } }));
+    // "ab" is reported since "abcd" turns out not to match, and the search continues after it
+    EXPECT_EQ(
+            matcher.find_all("abcx cdefg"),
+            (std::vector<PatternMatch>{ PatternMatch{ 2, 0, 2 }, PatternMatch{ 4, 5, 4 } })
+    );
+    EXPECT_EQ(matcher.find_all("abcdef"), (std::vector<PatternMatch>{ PatternMatch{ 1, 0, 4 } }));
+
+    auto const duplicates = MultiPatternMatcher{ std::vector<std::string>{ "aa", "aa" } };
+    EXPECT_EQ(
+            duplicates.find_all("aaaaa"),
+            (std::vector<PatternMatch>{ PatternMatch{ 0, 0, 2 }, PatternMatch{ 0, 2, 2 } })
+    );
+}
+
+TEST(MultiPatternMatcherTests, MatchesAfterPendingMatchAtEndOfText) {
+    // when the text ends, "ab" is still pending because "abcde" could have matched
+    auto const matcher = MultiPatternMatcher{
+        std::vector<std::pair<std::string, std::string>>{ { "ab", "X" }, { "abcde", "Y" }, { "c", "Z" } },
+    };
+    EXPECT_EQ(matcher.replace_all("abcd"), "XZd");
+    EXPECT_EQ(matcher.replace_all("abcdx"), "XZdx");
+    EXPECT_EQ(matcher.replace_all("abc"), "XZ");
+    EXPECT_EQ(matcher.replace_all("abcde"), "Y");
+
+    auto const overlapping = MultiPatternMatcher{ std::vector<std::string>{ "bc", "ccb", "c" } };
+    EXPECT_EQ(
+            overlapping.find_all("cacc"),
+            (std::vector<PatternMatch>{ PatternMatch{ 2, 0, 1 }, PatternMatch{ 2, 2, 1 }, PatternMatch{ 2, 3, 1 } })
+    );
+}
+
+TEST(MultiPatternMatcherTests, FindAllMatchesBruteForceSearch) {
+    auto generator = std::mt19937{ 42 };
+    auto const random_string = [&](std::size_t const min_length, std::size_t const max_length) {
+        auto result = std::string(std::uniform_int_distribution{ min_length, max_length }(generator), 'a');
+        for (auto& c : result) {
+            c = static_cast<char>('a' + std::uniform_int_distribution{ 0, 2 }(generator));
+        }
+        return result;
+    };
+    for (auto i = 0; i < 1000; ++i) {
+        auto patterns = std::vector<std::string>{};
+        for (auto j = 0; j < 3; ++j) {
+            patterns.push_back(random_string(1, 5));
+        }
+        auto const text = random_string(0, 12);
+
+        // leftmost-longest matches, the first occurrence of a pattern wins
+        auto expected = std::vector<PatternMatch>{};
+        auto offset = std::size_t{ 0 };
+        while (offset < text.size()) {
+            auto best = std::optional<PatternMatch>{};
+            for (auto index = std::size_t{ 0 }; index < patterns.size(); ++index) {
+                auto const& pattern = patterns[index];
+                if (text.compare(offset, pattern.size(), pattern) == 0
+                    and (not best.has_value() or pattern.size() > best->length)) {
+                    best = PatternMatch{ index, offset, pattern.size() };
+                }
+            }
+            if (best.has_value()) {
+                expected.push_back(*best);
+                offset += best->length;
+            } else {
+                ++offset;
+            }
+        }
+
+        auto const matcher = MultiPatternMatcher{ patterns };
+        EXPECT_EQ(matcher.find_all(text), expected) << "text: " << text;
+    }
+}
+
+TEST(MultiPatternMatcherTests, ReplaceAll) {
+    auto const matcher = MultiPatternMatcher{
+        std::vector<std::pair<std::string, std::string>>{
+                { "password", "********" },
+                { "secret", "[redacted]" },
+                { "Köln", "🏙️" },
+        },
+    };
+    EXPECT_EQ(matcher.replace_all("my password is secret"), "my ******** is [redacted]");
+    EXPECT_EQ(matcher.replace_all(std::string{ "secretsecret" }), "[redacted][redacted]");
+    EXPECT_EQ(matcher.replace_all(""), "");
+    EXPECT_EQ(matcher.replace_all("nothing to replace"), "nothing to replace");
+    EXPECT_EQ(matcher.replace_all("Grüße aus Köln"_utf8view), "Grüße aus 🏙️"_utf8view);
+
+    auto const without_replacements = MultiPatternMatcher{ std::vector<std::string>{ "a" } };
+    EXPECT_THROW(std::ignore = without_replacements.replace_all("abc"), std::logic_error);
+
+    // a pattern that is not valid UTF-8 must not produce an invalid result
+    auto const invalid = MultiPatternMatcher{
+        std::vector<std::pair<std::string, std::string>>{ { "\xC3", "x" } },
+    };
+    EXPECT_THROW(std::ignore = invalid.replace_all("ä"_utf8view), c2k::InvalidUtf8String);
+}
+
+TEST(MultiPatternMatcherTests, ReplaceAllMatchesRepeatedReplace) {
+    auto const patterns = std::vector<std::pair<std::string, std::string>>{
+        { "alpha", "1" },
+        { "beta", "22" },
+        { "gamma", "" },
+        { "ü", "ue" },
+    };
+    auto const matcher = MultiPatternMatcher{ patterns };
+    auto const words = std::vector<std::string>{ "alpha", "beta", "gamma", "ü", "delta", " ", "alp", "gam" };
+    auto generator = std::mt19937{ 42 };
+    for (auto i = 0; i < 100; ++i) {
+        auto text = std::string{};
+        for (auto j = 0; j < 50; ++j) {
+            text += words.at(std::uniform_int_distribution<std::size_t>{ 0, words.size() - 1 }(generator));
+        }
+        // the patterns cannot overlap each other, so replacing them one by one gives the same result
+        auto expected = text;
+        for (auto const& [pattern, replacement] : patterns) {
+            expected = c2k::replace(std::move(expected), pattern, replacement);
+        }
+        EXPECT_EQ(matcher.replace_all(text), expected);
+    }
+}
+
+TEST(MultiPatternMatcherTests, SharedBetweenThreads) {
+    auto const matcher = MultiPatternMatcher{
+        std::vector<std::pair<std::string, std::string>>{ { "foo", "bar" }, { "baz", "qux" } },
+    };
+    auto threads = std::vector<std::jthread>{};
+    auto results = std::vector<std::string>(4);
+    for (auto i = std::size_t{ 0 }; i < results.size(); ++i) {
+        threads.emplace_back([&matcher, &results, i] {
+            auto result = std::string{};
+            for (auto j = 0; j < 1000; ++j) {
+                result = matcher.replace_all("foo baz foo");
+            }
+            results[i] = result;
+        });
+    }
+    threads.clear();
+    for (auto const& result : results) {
+        EXPECT_EQ(result, "bar qux bar");
+    }
+}
@@ -0,0 +1,281 @@
+#include <array>
+#include <gtest/gtest.h>
+#include <lib2k/string_utils.hpp>
+#include <simd/simd.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// These tests call the kernels of every instruction set that the current CPU supports directly. The tests of the
+// string types only reach the kernels of the most capable one (through the runtime dispatch).
+
+using c2k::repeated;
+using c2k::detail::simd::InstructionSet;
+using c2k::detail::simd::Kernels;
+using c2k::detail::simd::LetterCase;
+using c2k::detail::simd::NibbleTables;
+
+namespace {
+    // The instruction sets are ordered by capability and each one requires the CPU to support the less capable ones.
+    [[nodiscard]] std::vector<Kernels> supported_kernels() {
+        static constexpr auto instruction_sets = std::array{
+            InstructionSet::Scalar,
+            InstructionSet::Sse4,
+            InstructionSet::Avx2,
+            InstructionSet::Avx512,
+        };
+        auto result = std::vector<Kernels>{};
+        for (auto const instruction_set : instruction_sets) {
+            if (instruction_set > c2k::detail::simd::active_instruction_set()) {
+                break;
+            }
+            result.push_back(c2k::detail::simd::kernels_for(instruction_set));
+        }
+        return result;
+    }
+
+    [[nodiscard]] char const* name(InstructionSet const instruction_set) {
+        switch (instruction_set) {
+            case InstructionSet::Scalar:
+                return "scalar";
+            case InstructionSet::Sse4:
+                return "SSE4.2";
+            case InstructionSet::Avx2:
+                return "AVX2";
+            case InstructionSet::Avx512:
+                return "AVX-512";
+        }
+        return "unknown";
+    }
+} // namespace
+
+TEST(SimdTests, KernelsForActiveInstructionSet) {
+    auto const active = c2k::detail::simd::active_instruction_set();
+    EXPECT_EQ(c2k::detail::simd::kernels_for(active).instruction_set, active);
+    EXPECT_EQ(supported_kernels().back().instruction_set, active);
+}
+
+TEST(SimdTests, ValidateUtf8AcrossBlockBoundaries) {
+    static constexpr auto valid_sequences = std::array{
+        "\xC2\x80",
+        "\xDF\xBF",
+        "\xE0\xA0\x80",
+        "\xED\x9F\xBF",
+        "\xEE\x80\x80",
+        "\xEF\xBF\xBF",
+        "\xF0\x90\x80\x80",
+        "\xF4\x8F\xBF\xBF",
+        "🦀",
+    };
+    static constexpr auto invalid_sequences = std::array{
+        "\x80",
+        "\xBF",
+        "\xC0\x80",
+        "\xC1\xBF",
+        "\xC2",
+        "\xC2\x41",
+        "\xE0\x80\x80",
+        "\xE0\x9F\xBF",
+        "\xED\xA0\x80",
+        "\xE2\x82",
+        "\xF0\x80\x80\x80",
+        "\xF0\x8F\xBF\xBF",
+        "\xF4\x90\x80\x80",
+        "\xF5\x80\x80\x80",
+        "\xF0\x9F\xA6",
+        "\xFE",
+        "\xFF",
+    };
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto offset = std::size_t{ 0 }; offset < 140; ++offset) {
+            auto const ascii = std::string(offset, 'a');
+            auto const ascii_result = kernels.validate_utf8(ascii.data(), ascii.size());
+            EXPECT_TRUE(ascii_result.is_valid) << "offset " << offset;
+            EXPECT_TRUE(ascii_result.is_ascii) << "offset " << offset;
+            for (auto const sequence : valid_sequences) {
+                auto const string = std::string(offset, 'a') + sequence + std::string(offset % 7, 'b');
+                auto const result = kernels.validate_utf8(string.data(), string.size());
+                EXPECT_TRUE(result.is_valid) << "offset " << offset;
+                EXPECT_FALSE(result.is_ascii) << "offset " << offset;
+            }
+            for (auto const sequence : invalid_sequences) {
+                auto const string = std::string(offset, 'a') + sequence + std::string(offset % 7, 'b');
+                EXPECT_FALSE(kernels.validate_utf8(string.data(), string.size()).is_valid) << "offset " << offset;
+                auto const multibyte_prefix = repeated("ä", offset) + sequence;
+                EXPECT_FALSE(kernels.validate_utf8(multibyte_prefix.data(), multibyte_prefix.size()).is_valid)
+                        << "offset " << offset;
+            }
+        }
+    }
+}
+
+TEST(SimdTests, AsciiPrefix) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto length = std::size_t{ 0 }; length < 140; ++length) {
+            auto const ascii = std::string(length, 'a');
+            EXPECT_TRUE(kernels.is_ascii(ascii.data(), ascii.size())) << "length " << length;
+            EXPECT_EQ(kernels.ascii_prefix_length(ascii.data(), ascii.size()), length) << "length " << length;
+            for (auto position = std::size_t{ 0 }; position < length; ++position) {
+                auto string = ascii;
+                string[position] = '\x80';
+                EXPECT_FALSE(kernels.is_ascii(string.data(), string.size())) << "position " << position;
+                EXPECT_EQ(kernels.ascii_prefix_length(string.data(), string.size()), position)
+                        << "position " << position;
+            }
+        }
+    }
+}
+
+TEST(SimdTests, CountCharsAndUtf16CodeUnits) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto count = std::size_t{ 0 }; count < 100; ++count) {
+            auto const string = repeated("aä€🦀", count) + repeated("ö", count % 13);
+            EXPECT_EQ(kernels.count_chars(string.data(), string.size()), 4 * count + count % 13) << "count " << count;
+            EXPECT_EQ(kernels.count_utf16_code_units(string.data(), string.size()), 5 * count + count % 13)
+                    << "count " << count;
+        }
+    }
+}
+
+TEST(SimdTests, ConvertAsciiCase) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto length = std::size_t{ 0 }; length < 300; ++length) {
+            auto source = std::string{};
+            auto uppercase = std::string{};
+            auto lowercase = std::string{};
+            for (auto i = std::size_t{ 0 }; i < length; ++i) {
+                auto const c = static_cast<char>(i % 128);
+                source += c;
+                uppercase += (c >= 'a' and c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+                lowercase += (c >= 'A' and c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+            }
+            source += "äA";
+            auto destination = std::string(source.size(), '\0');
+            EXPECT_EQ(
+                    kernels.convert_ascii_case(source.data(), source.size(), destination.data(), LetterCase::Upper),
+                    length
+            ) << "length "
+              << length;
+            EXPECT_EQ(destination.substr(0, length), uppercase) << "length " << length;
+            EXPECT_EQ(
+                    kernels.convert_ascii_case(source.data(), source.size(), destination.data(), LetterCase::Lower),
+                    length
+            ) << "length "
+              << length;
+            EXPECT_EQ(destination.substr(0, length), lowercase) << "length " << length;
+        }
+    }
+}
+
+TEST(SimdTests, MeasureAsciiWidth) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto count = std::size_t{ 0 }; count < 100; ++count) {
+            auto const string = repeated("ab\x01 \x7F", count) + "ä" + repeated("a", count);
+            auto const result = kernels.measure_ascii_width(string.data(), string.size());
+            EXPECT_EQ(result.num_bytes, 5 * count) << "count " << count;
+            EXPECT_EQ(result.width, 3 * count) << "count " << count;
+        }
+    }
+}
+
+TEST(SimdTests, AsciiCommonPrefixIgnoreCase) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto length = std::size_t{ 0 }; length < 140; ++length) {
+            auto const lhs = repeated("Hello, World! [@`{]", length).substr(0, length);
+            auto const rhs = repeated("hELLO, wORLD! [@`{]", length).substr(0, length);
+            EXPECT_EQ(kernels.ascii_common_prefix_ignore_case(lhs.data(), rhs.data(), length), length)
+                    << "length " << length;
+            for (auto position = std::size_t{ 0 }; position < length; ++position) {
+                auto mismatch = rhs;
+                mismatch[position] = '#';
+                EXPECT_EQ(kernels.ascii_common_prefix_ignore_case(lhs.data(), mismatch.data(), length), position)
+                        << "position " << position;
+                auto non_ascii = lhs;
+                non_ascii[position] = '\xC3';
+                auto const copy = non_ascii;
+                EXPECT_EQ(kernels.ascii_common_prefix_ignore_case(non_ascii.data(), copy.data(), length), position)
+                        << "position " << position;
+            }
+        }
+    }
+}
+
+TEST(SimdTests, WidenAndNarrowAscii) {
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto length = std::size_t{ 0 }; length < 140; ++length) {
+            auto const source = repeated("abc", length).substr(0, length) + "ä";
+            auto utf16 = std::u16string(source.size(), u'\0');
+            EXPECT_EQ(kernels.widen_ascii_to_utf16(source.data(), source.size(), utf16.data()), length);
+            auto utf32 = std::u32string(source.size(), U'\0');
+            EXPECT_EQ(kernels.widen_ascii_to_utf32(source.data(), source.size(), utf32.data()), length);
+            for (auto i = std::size_t{ 0 }; i < length; ++i) {
+                EXPECT_EQ(utf16[i], static_cast<char16_t>(source[i])) << "length " << length;
+                EXPECT_EQ(utf32[i], static_cast<char32_t>(source[i])) << "length " << length;
+            }
+
+            utf16[length] = u'ä';
+            utf32[length] = U'ä';
+            auto narrowed = std::string(source.size(), '\0');
+            EXPECT_EQ(kernels.narrow_ascii_from_utf16(utf16.data(), length + 1, narrowed.data()), length);
+            EXPECT_EQ(narrowed.substr(0, length), source.substr(0, length));
+            narrowed.assign(source.size(), '\0');
+            EXPECT_EQ(kernels.narrow_ascii_from_utf32(utf32.data(), length + 1, narrowed.data()), length);
+            EXPECT_EQ(narrowed.substr(0, length), source.substr(0, length));
+        }
+    }
+}
+
+TEST(SimdTests, FindSubstring) {
+    static constexpr auto needles = std::array<std::string_view, 4>{ "n", "ne", "needle", "needle in a haystack!" };
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto offset = std::size_t{ 0 }; offset < 140; ++offset) {
+            for (auto const needle : needles) {
+                // the partial needle in front of the real one must not be reported
+                auto const haystack = std::string(offset, 'a') + std::string{ needle.substr(0, needle.size() - 1) }
+                                      + "a" + std::string{ needle } + "aaa";
+                auto const expected = offset + needle.size();
+                EXPECT_EQ(
+                        kernels.find_substring(haystack.data(), haystack.size(), needle.data(), needle.size()),
+                        expected
+                ) << "offset "
+                  << offset;
+                auto const missing = std::string(offset, 'a');
+                EXPECT_EQ(
+                        kernels.find_substring(missing.data(), missing.size(), needle.data(), needle.size()),
+                        missing.size()
+                ) << "offset "
+                  << offset;
+            }
+        }
+    }
+}
+
+TEST(SimdTests, FindNibbleMatch) {
+    // matches '<' (0x3C) and '&' (0x26), but not '6' (0x36) or ',' (0x2C)
+    auto tables = NibbleTables{};
+    tables.low[0xC] = 0b01;
+    tables.high[0x3] = 0b01;
+    tables.low[0x6] = 0b10;
+    tables.high[0x2] = 0b10;
+    for (auto const& kernels : supported_kernels()) {
+        SCOPED_TRACE(name(kernels.instruction_set));
+        for (auto offset = std::size_t{ 0 }; offset < 140; ++offset) {
+            auto const string = repeated("6,", offset).substr(0, offset) + "&<";
+            EXPECT_EQ(kernels.find_nibble_match(string.data(), string.size(), tables), offset) << "offset " << offset;
+            auto const without_match = repeated("6,ä", offset);
+            EXPECT_EQ(
+                    kernels.find_nibble_match(without_match.data(), without_match.size(), tables),
+                    without_match.size()
+            ) << "offset "
+              << offset;
+        }
+    }
+}
@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 #include <lib2k/string_utils.hpp>
 #include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 TEST(StringUtilsTests, RegularLeftTrim) {
     using c2k::left_trim;
@@ -398,8 +403,112 @@ TEST(StringUtilsTests, Split) {
     EXPECT_EQ(split(";semi;colons;everywhere;", ";"), (std::vector{ ""s, "semi"s, "colons"s, "everywhere"s, ""s }));
 }
 
+TEST(StringUtilsTests, SplitView) {
+    using c2k::split;
+    using c2k::split_view;
+
+    for (auto const& [s, delimiter] : std::vector<std::pair<std::string, std::string_view>>{
+                 { "one;two;three", ";" },
+                 { "apple", "|" },
+                 { "", ";" },
+                 { ",,,", "," },
+                 { "data, more data, even more data", ", " },
+                 { ";semi;colons;everywhere;", ";" },
+         }) {
+        auto parts = std::vector<std::string>{};
+        for (auto const part : split_view(s, delimiter)) {
+            parts.emplace_back(part);
+        }
+        EXPECT_EQ(parts, split(s, delimiter));
+    }
+
+    // only the first parts are looked at
+    auto const fields = split_view("2024-01-01 12:00:00 INFO rest of the line", " ");
+    auto it = fields.begin();
+    EXPECT_EQ(*it, "2024-01-01");
+    EXPECT_EQ(*++it, "12:00:00");
+    EXPECT_EQ(*++it, "INFO");
+    EXPECT_EQ(std::ranges::distance(fields), 7);
+    EXPECT_EQ(std::ranges::next(fields.begin(), 7), fields.end());
+}
+
+TEST(StringUtilsTests, SplitInto) {
+    using c2k::split_into;
+
+    auto views = std::vector<std::string_view>{ "previous", "contents", "to", "be", "replaced" };
+    auto const capacity = views.capacity();
+    split_into("a,b,c", ",", views);
+    EXPECT_EQ(views, (std::vector<std::string_view>{ "a", "b", "c" }));
+    EXPECT_EQ(views.capacity(), capacity);
+
+    auto strings = std::vector<std::string>{};
+    split_into("first line that does not fit into the small buffer;x", ";", strings);
+    auto const* const first_buffer = strings.front().data();
+    split_into("short;y;z", ";", strings);
+    EXPECT_EQ(strings, (std::vector<std::string>{ "short", "y", "z" }));
+    EXPECT_EQ(strings.front().data(), first_buffer);
+    split_into("", ";", strings);
+    EXPECT_EQ(strings, std::vector<std::string>{ "" });
+}
+
+TEST(StringUtilsTests, Tokenize) {
+    using c2k::ByteSet;
+    using c2k::tokenize;
+
+    auto const delimiters = ByteSet{ ",; \t" };
+    auto tokens = std::vector<std::string_view>{};
+    for (auto const token : tokenize("  one, two;;three\tfour ,", delimiters)) {
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(tokens, (std::vector<std::string_view>{ "one", "two", "three", "four" }));
+    EXPECT_EQ(std::ranges::distance(tokenize("", delimiters)), 0);
+    EXPECT_EQ(std::ranges::distance(tokenize(",;, \t", delimiters)), 0);
+    EXPECT_EQ(*tokenize("no-delimiters", delimiters).begin(), "no-delimiters");
+    EXPECT_EQ(std::ranges::distance(tokenize("abc", ByteSet{})), 1);
+
+    auto spans = std::vector<c2k::TokenSpan>{ { 42, 42 } };
+    c2k::tokenize_into(";ab;;c", ByteSet{ ";" }, spans);
+    EXPECT_EQ(spans, (std::vector<c2k::TokenSpan>{ { 1, 2 }, { 5, 1 } }));
+}
+
+TEST(StringUtilsTests, TokenizeMatchesScalarReference) {
+    auto generator = std::mt19937{ 1234 };
+    // the last set contains non-ASCII bytes, for which the SIMD classification only acts as a prefilter
+    auto const delimiter_sets = std::vector<std::string>{ ",", " \t\n", "aeiou", "\x2c\xac\xe3\x01" };
+    auto const alphabet = std::string{ "abcdefghijklmnopqrstuvwxyz ,\t\n\x01\x81\xac\xe3\xff" };
+    auto distribution = std::uniform_int_distribution<std::size_t>{ 0, alphabet.size() - 1 };
+    for (auto const& delimiter_chars : delimiter_sets) {
+        auto const delimiters = c2k::ByteSet{ delimiter_chars };
+        for (auto const length : { 0, 1, 15, 16, 17, 63, 64, 65, 200, 1000 }) {
+            auto text = std::string{};
+            for (auto i = 0; i < length; ++i) {
+                text += alphabet[distribution(generator)];
+            }
+
+            auto expected = std::vector<c2k::TokenSpan>{};
+            auto token_start = std::string::npos;
+            for (auto i = std::size_t{ 0 }; i <= text.size(); ++i) {
+                auto const is_delimiter = i == text.size() or delimiter_chars.find(text[i]) != std::string::npos;
+                if (is_delimiter and token_start != std::string::npos) {
+                    expected.push_back({ token_start, i - token_start });
+                    token_start = std::string::npos;
+                } else if (not is_delimiter and token_start == std::string::npos) {
+                    token_start = i;
+                }
+            }
+
+            auto spans = std::vector<c2k::TokenSpan>{};
+            c2k::tokenize_into(text, delimiters, spans);
+            ASSERT_EQ(spans, expected) << "delimiters: " << delimiter_chars << ", text: " << text;
+        }
+    }
+}
+
 TEST(StringUtilsTests, SplitWithEmptyDelimiterFails) {
     EXPECT_THROW({ std::ignore = c2k::split("1, 2, 3", ""); }, std::invalid_argument);
+    EXPECT_THROW({ std::ignore = c2k::split_view("1, 2, 3", ""); }, std::invalid_argument);
+    auto parts = std::vector<std::string_view>{};
+    EXPECT_THROW({ c2k::split_into("1, 2, 3", "", parts); }, std::invalid_argument);
 }
 
 TEST(StringUtilsTests, Join) {
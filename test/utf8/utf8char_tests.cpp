@@ -12,6 +12,31 @@ TEST(Utf8CharTests, Construction) {
     EXPECT_NO_THROW(std::ignore = Utf8Char{ '\n' });
 }
 
+TEST(Utf8CharTests, CompactRepresentation) {
+    static_assert(sizeof(Utf8Char) == 4);
+    static_assert(std::is_trivially_copyable_v<Utf8Char>);
+
+    static constexpr auto a = Utf8Char{ 'a' };
+    static constexpr auto crab_bytes = std::array{
+        std::byte{ 0xF0 },
+        std::byte{ 0x9F },
+        std::byte{ 0xA6 },
+        std::byte{ 0x80 },
+    };
+    static constexpr auto crab = Utf8Char::from_bytes_unchecked(crab_bytes);
+    static_assert(a != crab);
+    static_assert(Utf8Char{} == Utf8Char{ '\0' });
+    EXPECT_EQ(a.as_string_view(), "a");
+    EXPECT_EQ(crab.as_string_view(), "🦀");
+    EXPECT_EQ(crab, "🦀"_utf8.front());
+    EXPECT_EQ(Utf8Char::from_bytes(std::span{ crab_bytes }.first(2)).error(), c2k::Utf8Error::InvalidUtf8Char);
+    EXPECT_EQ("ä€"_utf8.front().as_string_view(), "ä");
+    EXPECT_EQ(Utf8Char::from_codepoint(0x110000).error(), c2k::Utf8Error::InvalidUtf8Char);
+    EXPECT_EQ(Utf8Char::from_codepoint(0xD800).error(), c2k::Utf8Error::InvalidUtf8Char);
+    EXPECT_EQ(Utf8Char::from_codepoint(0xFFFF).value().as_string_view(), "\xEF\xBF\xBF");
+    EXPECT_THROW(std::ignore = Utf8Char{ '\xC3' }, c2k::InvalidUtf8Char);
+}
+
 TEST(Utf8CharTests, UserDefinedLiteral) {
     EXPECT_EQ(Utf8Char{ 'a' }, 'a'_utf8);
     EXPECT_EQ(Utf8Char{ ' ' }, ' '_utf8);
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <unordered_set>
+#include <vector>
+
+using c2k::Utf8Error;
+using c2k::Utf8String;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+using InlineString = c2k::InlineUtf8String<48>;
+
+TEST(Utf8InlineStringTests, Construction) {
+    // the inline bytes share their storage with the heap buffer
+    static_assert(sizeof(InlineString) <= InlineString::max_inline_size() + 1 + 2 * sizeof(std::size_t) + 8);
+
+    auto const empty = InlineString{};
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_STREQ(empty.c_str(), "");
+
+    auto const short_string = InlineString{ "Grüße, 🌍!" };
+    EXPECT_TRUE(short_string.is_inline());
+    EXPECT_EQ(short_string, "Grüße, 🌍!"_utf8view);
+    EXPECT_STREQ(short_string.c_str(), "Grüße, 🌍!");
+    EXPECT_EQ(short_string.calculate_char_count(), 9);
+    EXPECT_FALSE(short_string.is_ascii());
+
+    EXPECT_EQ(InlineString{ "abc"_utf8 }, "abc"_utf8);
+    EXPECT_EQ(InlineString{ std::string{ "abc" } }, "abc"_utf8view);
+    EXPECT_TRUE(InlineString{ "abc" }.is_ascii());
+
+    EXPECT_THROW(std::ignore = InlineString{ "Hello, \xff!" }, c2k::InvalidUtf8String);
+    EXPECT_EQ(InlineString::from_chars("\xE0\xA0"), tl::unexpected{ Utf8Error::InvalidUtf8String });
+    EXPECT_EQ(InlineString::from_chars("äöü").value(), "äöü"_utf8view);
+}
+
+TEST(Utf8InlineStringTests, GrowsBeyondInlineCapacity) {
+    auto string = InlineString{};
+    auto expected = Utf8String{};
+    for (auto i = 0; i < 20; ++i) {
+        EXPECT_EQ(string.is_inline(), string.num_bytes() <= InlineString::max_inline_size());
+        string += "ä🌍x"_utf8view;
+        expected += "ä🌍x"_utf8view;
+        EXPECT_EQ(string, expected);
+        EXPECT_STREQ(string.c_str(), expected.c_str());
+    }
+    EXPECT_FALSE(string.is_inline());
+    EXPECT_EQ(string.calculate_char_count(), 60);
+
+    // appending a string to itself works in both storage modes
+    auto doubled = InlineString{ "abc" };
+    doubled += doubled;
+    EXPECT_EQ(doubled, "abcabc"_utf8view);
+    auto long_doubled = InlineString{ "0123456789012345678901234567890123456789" };
+    long_doubled += long_doubled;
+    EXPECT_EQ(long_doubled.num_bytes(), 80);
+    EXPECT_EQ(long_doubled.substring(40), "0123456789012345678901234567890123456789"_utf8view);
+
+    string.clear();
+    EXPECT_TRUE(string.is_empty());
+    EXPECT_TRUE(string.is_inline());
+    string += c2k::Utf8Char{ 'a' };
+    EXPECT_EQ(string, "a"_utf8view);
+}
+
+TEST(Utf8InlineStringTests, CopyAndMove) {
+    for (auto const text : { "short ä", "a string that does not fit into the inline buffer: äöü" }) {
+        auto const original = InlineString{ text };
+        auto copy = original;
+        EXPECT_EQ(copy, original);
+        auto moved = std::move(copy);
+        EXPECT_EQ(moved, original);
+        EXPECT_TRUE(copy.is_empty()); // NOLINT (use after move)
+        auto assigned = InlineString{ "x" };
+        assigned = std::move(moved);
+        EXPECT_EQ(assigned, original);
+        EXPECT_STREQ(assigned.c_str(), text);
+    }
+}
+
+TEST(Utf8InlineStringTests, ConversionsAndStringOperations) {
+    auto const string = InlineString{ "Hello, 🌍, and hello again" };
+    Utf8StringView const view = string;
+    EXPECT_EQ(view.view().data(), string.c_str());
+    EXPECT_EQ(string.to_string(), "Hello, 🌍, and hello again"_utf8);
+    EXPECT_EQ(string.front(), c2k::Utf8Char{ 'H' });
+    EXPECT_EQ(string.back(), c2k::Utf8Char{ 'n' });
+    EXPECT_EQ(string.substring(7, 1), "🌍"_utf8view);
+    EXPECT_EQ(string.find("hello"_utf8view) - string.begin(), 14);
+    EXPECT_EQ(string.split(", "), (std::vector<Utf8StringView>{ "Hello", "🌍", "and hello again" }));
+    EXPECT_EQ(*string.codepoints().begin(), U'H');
+
+    auto const long_string = InlineString{ "a string that does not fit into the inline buffer: äöü" };
+    EXPECT_EQ(long_string.to_string(), "a string that does not fit into the inline buffer: äöü"_utf8);
+
+    auto set = std::unordered_set<InlineString>{};
+    set.insert("äöü");
+    set.insert("a string that does not fit into the inline buffer: äöü");
+    EXPECT_TRUE(set.contains("äöü"));
+    EXPECT_FALSE(set.contains("äö"));
+}
+
+TEST(Utf8InlineStringTests, ComparisonWithStringLiterals) {
+    EXPECT_TRUE(InlineString{ "abc" } == "abc");
+    EXPECT_FALSE(InlineString{ "abc" } == "abd");
+    EXPECT_TRUE(InlineString{ "a string that does not fit into the inline buffer: äöü" }
+                == "a string that does not fit into the inline buffer: äöü");
+    EXPECT_EQ(InlineString{ "Grüße" }, "Grüße");
+}
+
+TEST(Utf8InlineStringTests, FindWithStartPosition) {
+    auto const string = InlineString{ "hello 🌍, hello again" };
+    EXPECT_EQ(string.find("hello"_utf8view, 1) - string.begin(), 9);
+    EXPECT_EQ(string.find("hello"_utf8view, string.begin() + 1) - string.begin(), 9);
+    EXPECT_EQ(string.find(c2k::Utf8Char{ 'l' }, 5) - string.begin(), 11);
+    EXPECT_EQ(string.find(c2k::Utf8Char{ 'l' }, string.begin() + 5) - string.begin(), 11);
+    EXPECT_EQ(string.find(c2k::Utf8Searcher{ "again" }) - string.begin(), 15);
+    EXPECT_EQ(string.find("missing"_utf8view, 1), string.end());
+}
+
+TEST(Utf8InlineStringTests, ReplaceAndCaseConversion) {
+    auto const string = InlineString{ "hello 🌍, hello" };
+    EXPECT_EQ(string.replace("hello", "bye"), "bye 🌍, bye");
+    EXPECT_EQ(string.replace("hello", "bye", c2k::MaxReplacementCount{ 1 }), "bye 🌍, hello");
+    EXPECT_EQ(string.replace("hello", "bye", string.begin() + 1), "hello 🌍, bye");
+    EXPECT_EQ(string.replace(c2k::Utf8Searcher{ "hello" }, "bye"), "bye 🌍, bye");
+
+    // a replacement result that does not fit inline is moved to the heap
+    auto const replaced = string.replace("🌍", "a replacement that does not fit inline");
+    EXPECT_FALSE(replaced.is_inline());
+    EXPECT_EQ(replaced, "hello a replacement that does not fit inline, hello");
+
+    EXPECT_EQ(string.to_uppercase(), "HELLO 🌍, HELLO");
+    EXPECT_EQ(InlineString{ "HELLO 🌍" }.to_lowercase(), "hello 🌍");
+    auto converted = InlineString{ "hello 🌍" };
+    converted.make_uppercase();
+    EXPECT_EQ(converted, "HELLO 🌍");
+    converted.make_lowercase();
+    EXPECT_EQ(converted, "hello 🌍");
+}
+
+TEST(Utf8InlineStringTests, Erase) {
+    auto string = InlineString{ "a🌍bc" };
+    auto const next = string.erase(string.begin() + 1);
+    EXPECT_EQ(string, "abc");
+    EXPECT_EQ(*next, c2k::Utf8Char{ 'b' });
+    auto const end = string.erase(string.begin() + 1, string.end());
+    EXPECT_EQ(end, string.end());
+    EXPECT_EQ(string, "a");
+    EXPECT_STREQ(string.c_str(), "a");
+
+    // erasing moves the data back into the object once it fits
+    auto long_string = InlineString{ "a string that does not fit into the inline buffer: äöü" };
+    EXPECT_FALSE(long_string.is_inline());
+    long_string.erase(long_string.begin() + 8, long_string.begin() + 49);
+    EXPECT_TRUE(long_string.is_inline());
+    EXPECT_EQ(long_string, "a string: äöü");
+    EXPECT_STREQ(long_string.c_str(), "a string: äöü");
+    long_string += "x"_utf8view;
+    EXPECT_EQ(long_string, "a string: äöüx");
+}
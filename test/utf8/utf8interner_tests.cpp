@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using c2k::Utf8Atom;
+using c2k::Utf8Interner;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+TEST(Utf8InternerTests, Interning) {
+    auto interner = Utf8Interner{};
+    auto const hello = interner.intern("Hello, 🌍!");
+    auto const other_hello = interner.intern(std::string{ "Hello, " } + "🌍!");
+    auto const world = interner.intern("world");
+    EXPECT_EQ(hello, other_hello);
+    EXPECT_NE(hello, world);
+    EXPECT_EQ(hello.view().data(), other_hello.view().data());
+    EXPECT_EQ(hello.as_view(), "Hello, 🌍!"_utf8view);
+    EXPECT_EQ(hello.hash(), std::hash<Utf8StringView>{}("Hello, 🌍!"));
+    EXPECT_FALSE(hello.as_view().is_ascii());
+    EXPECT_TRUE(world.as_view().is_ascii());
+    EXPECT_EQ(interner.size(), 2);
+
+    EXPECT_EQ(interner.find("world"), world);
+    EXPECT_EQ(interner.find("unknown"), std::nullopt);
+
+    auto const empty = interner.intern("");
+    EXPECT_EQ(empty, Utf8Atom{});
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(Utf8Atom{}.as_view(), ""_utf8view);
+    EXPECT_EQ(interner.size(), 2);
+
+    auto set = std::unordered_set<Utf8Atom>{ hello, world, other_hello };
+    EXPECT_EQ(set.size(), 2);
+}
+
+TEST(Utf8InternerTests, AtomsStayValidWhenTheInternerGrows) {
+    auto interner = Utf8Interner{};
+    auto atoms = std::vector<Utf8Atom>{};
+    for (auto i = 0; i < 10'000; ++i) {
+        atoms.push_back(interner.intern("tag-ä-" + std::to_string(i)));
+    }
+    auto const long_string = std::string(100'000, 'x');
+    auto const long_atom = interner.intern(long_string);
+    EXPECT_EQ(interner.size(), 10'001);
+    for (auto i = 0; i < 10'000; ++i) {
+        auto const expected = "tag-ä-" + std::to_string(i);
+        ASSERT_EQ(atoms[static_cast<std::size_t>(i)].view(), expected);
+        ASSERT_EQ(interner.intern(expected), atoms[static_cast<std::size_t>(i)]);
+    }
+    EXPECT_EQ(long_atom.view(), long_string);
+    EXPECT_EQ(interner.find(long_string), long_atom);
+}
+
+TEST(Utf8InternerTests, ConcurrentInterning) {
+    static constexpr auto num_threads = 8;
+    static constexpr auto num_strings = 2'000;
+    auto interner = Utf8Interner{};
+    auto results = std::vector<std::vector<Utf8Atom>>(num_threads);
+    auto threads = std::vector<std::jthread>{};
+    for (auto thread_index = 0; thread_index < num_threads; ++thread_index) {
+        threads.emplace_back([&, thread_index] {
+            auto& atoms = results[static_cast<std::size_t>(thread_index)];
+            for (auto i = 0; i < num_strings; ++i) {
+                // every thread starts at a different string
+                auto const n = (i + thread_index * 251) % num_strings;
+                atoms.push_back(interner.intern("string " + std::to_string(n)));
+            }
+        });
+    }
+    threads.clear();
+
+    EXPECT_EQ(interner.size(), num_strings);
+    for (auto i = 0; i < num_strings; ++i) {
+        auto const expected = interner.find("string " + std::to_string(i));
+        ASSERT_TRUE(expected.has_value());
+        for (auto thread_index = 0; thread_index < num_threads; ++thread_index) {
+            auto const position = (i - thread_index * 251 % num_strings + num_strings) % num_strings;
+            ASSERT_EQ(results[static_cast<std::size_t>(thread_index)][static_cast<std::size_t>(position)], expected);
+        }
+    }
+}
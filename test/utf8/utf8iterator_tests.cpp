@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <gtest/gtest.h>
 #include <lib2k/utf8.hpp>
+#include <vector>
 
 using namespace c2k::Utf8Literals;
 
@@ -109,3 +110,69 @@ TEST(Utf8ConstReverseIteratorTests, Base) {
     EXPECT_EQ(*(forward_iterator + 1), '.');
     EXPECT_EQ(forward_iterator + 2, string.cend());
 }
+
+TEST(Utf8RangeTests, Codepoints) {
+    auto const string = "aä€🐀!"_utf8view;
+    auto codepoints = std::vector<char32_t>{};
+    for (auto const codepoint : string.codepoints()) {
+        codepoints.push_back(codepoint);
+    }
+    EXPECT_EQ(codepoints, (std::vector<char32_t>{ U'a', U'ä', U'€', U'🐀', U'!' }));
+    EXPECT_TRUE(""_utf8view.codepoints().empty());
+    EXPECT_EQ(std::ranges::distance("Hello, 🌍!"_utf8.codepoints()), 9);
+
+    for (auto it = string.cbegin(); auto const codepoint : string.codepoints()) {
+        EXPECT_EQ(static_cast<std::int32_t>(codepoint), it->codepoint());
+        ++it;
+    }
+}
+
+TEST(Utf8RangeTests, CharSpans) {
+    auto const string = "The quick brown 🦊 jumps over the lazy 🐶."_utf8;
+    auto it = string.cbegin();
+    for (auto const span : string.char_spans()) {
+        ASSERT_NE(it, string.cend());
+        EXPECT_EQ(c2k::Utf8Char::from_bytes_unchecked(span), *it);
+        ++it;
+    }
+    EXPECT_EQ(it, string.cend());
+
+    // the view is not null-terminated, so the last char must not be decoded beyond the end of the view
+    auto const view = c2k::Utf8StringView{ string }.substring(10, 7);
+    auto const spans = std::vector(view.char_spans().begin(), view.char_spans().end());
+    ASSERT_EQ(spans.size(), 7);
+    EXPECT_EQ(spans.back().size(), 4);
+    auto const view_end = reinterpret_cast<std::byte const*>(view.view().data() + view.num_bytes());
+    EXPECT_EQ(spans.back().data() + spans.back().size(), view_end);
+}
+
+TEST(Utf8RangeTests, Graphemes) {
+    using c2k::Utf8StringView;
+    auto const string = "aé👨‍👩‍👧🇩🇪🇫🇷\r\nx"_utf8;
+    auto clusters = std::vector<Utf8StringView>{};
+    for (auto const cluster : string.graphemes()) {
+        clusters.push_back(cluster);
+    }
+    auto const expected = std::vector<Utf8StringView>{
+        "a", "é", "👨‍👩‍👧", "🇩🇪", "🇫🇷", "\r\n", "x",
+    };
+    EXPECT_EQ(clusters, expected);
+    EXPECT_TRUE(""_utf8view.graphemes().empty());
+    EXPECT_EQ(std::ranges::distance("Hello, 🌍!"_utf8view.graphemes()), 9);
+
+    // feeding the string in chunks must produce the same boundaries as a single pass
+    auto boundaries = std::vector<std::size_t>{};
+    for (auto const cluster : string.graphemes()) {
+        boundaries.push_back(static_cast<std::size_t>(cluster.view().data() - string.view().data()));
+    }
+    auto breaker = c2k::Utf8GraphemeBreaker{};
+    auto chunked_boundaries = std::vector<std::size_t>{};
+    for (auto const span : string.char_spans()) {
+        auto const chunk = std::string_view{ reinterpret_cast<char const*>(span.data()), span.size() };
+        auto const offset = static_cast<std::size_t>(chunk.data() - string.view().data());
+        if (auto const last_break = breaker.find_last_break(chunk); last_break.has_value()) {
+            chunked_boundaries.push_back(offset + last_break.value());
+        }
+    }
+    EXPECT_EQ(chunked_boundaries, boundaries);
+}
@@ -0,0 +1,120 @@
+#include <array>
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <memory_resource>
+#include <unordered_set>
+#include <vector>
+
+using c2k::MaxReplacementCount;
+using c2k::Utf8Error;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+namespace {
+    // All allocations have to be served from the buffer since the upstream resource always fails.
+    class Arena final {
+    private:
+        std::array<std::byte, 16 * 1024> m_buffer{};
+        std::pmr::monotonic_buffer_resource m_resource{
+            m_buffer.data(),
+            m_buffer.size(),
+            std::pmr::null_memory_resource(),
+        };
+
+    public:
+        [[nodiscard]] std::pmr::memory_resource* resource() {
+            return &m_resource;
+        }
+    };
+} // namespace
+
+TEST(Utf8PmrStringTests, Construction) {
+    auto arena = Arena{};
+    auto const text = "a string that is too long for the small string optimization 🌍";
+    auto const string = c2k::pmr::Utf8String{ text, arena.resource() };
+    EXPECT_EQ(string.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(string, Utf8StringView{ text });
+    EXPECT_FALSE(string.is_ascii());
+    EXPECT_EQ(string.calculate_char_count(), 61);
+
+    auto const from_view = c2k::pmr::Utf8String{ "äöü"_utf8view, arena.resource() };
+    EXPECT_EQ(from_view.to_string(), "äöü"_utf8);
+    EXPECT_THROW(std::ignore = c2k::pmr::Utf8String{ "\xE0\xA0" }, c2k::InvalidUtf8String);
+    EXPECT_EQ(c2k::pmr::Utf8String::from_chars("\xFF"), tl::unexpected{ Utf8Error::InvalidUtf8String });
+    EXPECT_EQ(c2k::pmr::Utf8String::from_chars("abc", arena.resource())->get_allocator().resource(), arena.resource());
+
+    // copies use the default resource (as std::pmr::string does), unless a resource is passed
+    auto const copy = string;
+    EXPECT_EQ(copy, string);
+    EXPECT_EQ(copy.get_allocator().resource(), std::pmr::get_default_resource());
+    auto const arena_copy = c2k::pmr::Utf8String{ copy, arena.resource() };
+    EXPECT_EQ(arena_copy.get_allocator().resource(), arena.resource());
+
+    auto appended = c2k::pmr::Utf8String{ arena.resource() };
+    appended += "Hello"_utf8view;
+    appended += c2k::Utf8Char{ ',' };
+    appended += " 🌍"_utf8view;
+    EXPECT_EQ(appended, "Hello, 🌍"_utf8);
+    EXPECT_EQ(appended.get_allocator().resource(), arena.resource());
+}
+
+TEST(Utf8PmrStringTests, ComparisonWithStringLiterals) {
+    auto arena = Arena{};
+    auto const string = c2k::pmr::Utf8String{ "Grüße, 🌍!", arena.resource() };
+    EXPECT_TRUE(string == "Grüße, 🌍!");
+    EXPECT_FALSE(string == "Grüße");
+    EXPECT_EQ(string, "Grüße, 🌍!");
+    EXPECT_TRUE(c2k::pmr::Utf8String{} == "");
+}
+
+TEST(Utf8PmrStringTests, OperationsAllocateFromTheMemoryResource) {
+    auto arena = Arena{};
+    auto other_arena = Arena{};
+    auto const text = "Hallöchen aus Köln, Hallöchen aus Bonn, Hallöchen aus Ulm"_utf8view;
+    auto const string = c2k::pmr::Utf8String{ text, arena.resource() };
+
+    auto const upper = string.to_uppercase();
+    EXPECT_EQ(upper, "HALLÖCHEN AUS KÖLN, HALLÖCHEN AUS BONN, HALLÖCHEN AUS ULM"_utf8view);
+    EXPECT_EQ(upper.get_allocator().resource(), arena.resource());
+    auto const lower = string.to_lowercase(other_arena.resource());
+    EXPECT_EQ(lower, "hallöchen aus köln, hallöchen aus bonn, hallöchen aus ulm"_utf8view);
+    EXPECT_EQ(lower.get_allocator().resource(), other_arena.resource());
+
+    auto const substring = string.substring(10, 9);
+    EXPECT_EQ(substring, "aus Köln,"_utf8view);
+    EXPECT_EQ(substring.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(string.substring(54), "Ulm"_utf8view);
+    EXPECT_EQ(string.substring(54).get_allocator().resource(), arena.resource());
+    auto const suffix = string.substring(40, other_arena.resource());
+    EXPECT_EQ(suffix, "Hallöchen aus Ulm"_utf8view);
+    EXPECT_EQ(suffix.get_allocator().resource(), other_arena.resource());
+
+    auto const replaced = string.replace("Hallöchen", "Hallo");
+    EXPECT_EQ(replaced, "Hallo aus Köln, Hallo aus Bonn, Hallo aus Ulm"_utf8view);
+    EXPECT_EQ(replaced.get_allocator().resource(), arena.resource());
+    auto const replaced_once = string.replace("Hallöchen", "Hi", MaxReplacementCount{ 1 }, other_arena.resource());
+    EXPECT_EQ(replaced_once, "Hi aus Köln, Hallöchen aus Bonn, Hallöchen aus Ulm"_utf8view);
+    EXPECT_EQ(replaced_once.get_allocator().resource(), other_arena.resource());
+
+    auto const parts = string.split(", ");
+    ASSERT_EQ(parts.size(), 3);
+    EXPECT_EQ(parts.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(parts[1], "Hallöchen aus Bonn"_utf8view);
+    for (auto const& part : parts) {
+        EXPECT_EQ(part.get_allocator().resource(), arena.resource());
+    }
+
+    auto const separator = c2k::pmr::Utf8String{ " | ", arena.resource() };
+    auto const joined = separator.join(parts, other_arena.resource());
+    EXPECT_EQ(joined, "Hallöchen aus Köln | Hallöchen aus Bonn | Hallöchen aus Ulm"_utf8view);
+    EXPECT_EQ(joined.get_allocator().resource(), other_arena.resource());
+    EXPECT_EQ(separator.join(std::vector<Utf8StringView>{}), ""_utf8view);
+
+    auto const views = Utf8StringView{ string }.split(", ", arena.resource());
+    EXPECT_EQ(views.size(), 3);
+    EXPECT_EQ(views.get_allocator().resource(), arena.resource());
+
+    auto set = std::unordered_set<c2k::pmr::Utf8String>{};
+    set.insert(parts.cbegin(), parts.cend());
+    EXPECT_TRUE(set.contains("Hallöchen aus Ulm"));
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <array>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using c2k::Utf8Rope;
+using c2k::Utf8String;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+namespace {
+    [[nodiscard]] Utf8String make_text(std::size_t const num_lines) {
+        auto result = Utf8String{};
+        for (auto i = std::size_t{ 0 }; i < num_lines; ++i) {
+            result += Utf8StringView{ "line " + std::to_string(i) + ": Grüße aus Köln 🌍🐸\n" };
+        }
+        return result;
+    }
+} // namespace
+
+TEST(Utf8RopeTests, Construction) {
+    auto const empty = Utf8Rope{};
+    EXPECT_TRUE(empty.is_empty());
+    EXPECT_EQ(empty.char_count(), 0);
+    EXPECT_EQ(empty.begin(), empty.end());
+    EXPECT_EQ(empty, ""_utf8view);
+
+    auto const text = make_text(1000);
+    auto const rope = Utf8Rope{ text };
+    EXPECT_FALSE(rope.is_empty());
+    EXPECT_EQ(rope.num_bytes(), text.num_bytes());
+    EXPECT_EQ(rope.char_count(), text.calculate_char_count());
+    EXPECT_EQ(rope, text);
+    EXPECT_EQ(rope.to_string(), text);
+
+    auto const chunks = rope.chunks();
+    EXPECT_GT(chunks.size(), 1);
+    auto concatenated = Utf8String{};
+    for (auto const chunk : chunks) {
+        EXPECT_LE(chunk.num_bytes(), Utf8Rope::max_chunk_size);
+        concatenated += chunk;
+    }
+    EXPECT_EQ(concatenated, text);
+}
+
+TEST(Utf8RopeTests, CharAccessAndIteration) {
+    auto const text = make_text(200);
+    auto const rope = Utf8Rope{ text };
+    auto i = std::size_t{ 0 };
+    auto rope_iterator = rope.begin();
+    for (auto const c : text) {
+        ASSERT_NE(rope_iterator, rope.end());
+        EXPECT_EQ(*rope_iterator, c);
+        EXPECT_EQ(rope.char_at(i), c);
+        ++rope_iterator;
+        ++i;
+    }
+    EXPECT_EQ(rope_iterator, rope.end());
+    EXPECT_EQ(rope.end().byte_offset(), text.num_bytes());
+    EXPECT_THROW(std::ignore = rope.char_at(rope.char_count()), std::out_of_range);
+
+    auto const iterator = rope.iterator_at(8);
+    EXPECT_EQ(*iterator, c2k::Utf8Char{ 'G' });
+    EXPECT_EQ(iterator.byte_offset(), 8);
+    EXPECT_EQ(rope.iterator_at(rope.char_count()), rope.end());
+}
+
+TEST(Utf8RopeTests, InsertAndErase) {
+    auto rope = Utf8Rope{ "Hello, world!"_utf8view };
+    rope.insert(7, "beautiful 🌍 "_utf8view);
+    EXPECT_EQ(rope, "Hello, beautiful 🌍 world!"_utf8view);
+    rope.insert(0, ">> "_utf8view);
+    rope.append(" <<"_utf8view);
+    EXPECT_EQ(rope, ">> Hello, beautiful 🌍 world! <<"_utf8view);
+    rope.erase(10, 12);
+    EXPECT_EQ(rope, ">> Hello, world! <<"_utf8view);
+    rope.erase(16, 100);
+    EXPECT_EQ(rope, ">> Hello, world!"_utf8view);
+    EXPECT_THROW(rope.insert(17, "x"_utf8view), std::out_of_range);
+    EXPECT_THROW(rope.erase(17, 1), std::out_of_range);
+    rope.erase(0, rope.char_count());
+    EXPECT_TRUE(rope.is_empty());
+
+    rope.append(make_text(10));
+    rope.clear();
+    EXPECT_TRUE(rope.is_empty());
+    EXPECT_EQ(rope.char_count(), 0);
+}
+
+TEST(Utf8RopeTests, RandomizedEditsMatchUtf8String) {
+    auto expected = make_text(300);
+    auto rope = Utf8Rope{ expected };
+    auto const insertions = std::array{ "x"_utf8view, "Grüße 🐸"_utf8view, ""_utf8view, "ö"_utf8view };
+    auto const large_insertion = make_text(50);
+    auto generator = std::mt19937{ 42 };
+    for (auto i = std::size_t{ 0 }; i < 2000; ++i) {
+        auto const char_count = expected.calculate_char_count();
+        auto const position = std::uniform_int_distribution<std::size_t>{ 0, char_count }(generator);
+        if (i % 2 == 0) {
+            auto const text = (i % 100 == 0) ? Utf8StringView{ large_insertion } : insertions.at(i / 2 % 4);
+            rope.insert(position, text);
+            auto edited = expected.substring(0, position);
+            edited += text;
+            edited += expected.substring(position);
+            expected = std::move(edited);
+        } else {
+            auto const count = std::uniform_int_distribution<std::size_t>{ 0, 20 }(generator);
+            rope.erase(position, count);
+            auto edited = expected.substring(0, position);
+            edited += expected.substring(std::min(position + count, char_count));
+            expected = std::move(edited);
+        }
+        ASSERT_EQ(rope.char_count(), expected.calculate_char_count());
+        ASSERT_EQ(rope.num_bytes(), expected.num_bytes());
+    }
+    EXPECT_EQ(rope, expected);
+    EXPECT_EQ(rope.to_string(), expected);
+    for (auto const chunk : rope.chunks()) {
+        EXPECT_LE(chunk.num_bytes(), Utf8Rope::max_chunk_size);
+    }
+}
+
+TEST(Utf8RopeTests, Find) {
+    auto const text = make_text(500);
+    auto const rope = Utf8Rope{ text };
+    auto const needles = std::array{
+        "line 0:"_utf8view,
+        "line 123: Grüße"_utf8view,
+        "🐸\nline 499"_utf8view,
+        "🌍🐸"_utf8view,
+    };
+    for (auto const needle : needles) {
+        auto const position = rope.find(needle);
+        ASSERT_NE(position, rope.end());
+        EXPECT_EQ(position.byte_offset(), text.view().find(needle.view()));
+    }
+    EXPECT_EQ(rope.find("not contained"_utf8view), rope.end());
+    EXPECT_EQ(rope.find(""_utf8view), rope.begin());
+
+    // every line boundary is a candidate for a match that spans two chunks
+    for (auto i = std::size_t{ 0 }; i < 500; i += 7) {
+        auto const needle = Utf8String{ "Köln 🌍🐸\nline " + std::to_string(i + 1) + ":" };
+        auto const position = rope.find(needle);
+        ASSERT_NE(position, rope.end());
+        EXPECT_EQ(position.byte_offset(), text.view().find(needle.view()));
+    }
+
+    auto const second = rope.find("Grüße"_utf8view, 10);
+    ASSERT_NE(second, rope.end());
+    EXPECT_EQ(second.byte_offset(), text.view().find("Grüße", 10));
+    EXPECT_EQ(rope.find("line"_utf8view, rope.char_count()), rope.end());
+}
+
+TEST(Utf8RopeTests, CopyIsIndependent) {
+    auto original = Utf8Rope{ make_text(100) };
+    auto copy = original;
+    EXPECT_EQ(copy, original.to_string());
+    copy.insert(5, "🐸"_utf8view);
+    original.erase(0, 5);
+    EXPECT_EQ(copy.char_count(), make_text(100).calculate_char_count() + 1);
+    EXPECT_EQ(original.char_count(), make_text(100).calculate_char_count() - 5);
+    auto moved = std::move(copy);
+    EXPECT_EQ(moved.char_at(5), c2k::Utf8Char::from_codepoint(0x1F438).value());
+}
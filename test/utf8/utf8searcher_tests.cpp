@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using c2k::Utf8Searcher;
+using c2k::Utf8String;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+namespace {
+    [[nodiscard]] std::string random_text(std::mt19937& generator, std::size_t const length) {
+        // a small alphabet produces lots of partial matches
+        static constexpr auto alphabet = std::string_view{ "abcab" };
+        auto result = std::string{};
+        auto distribution = std::uniform_int_distribution<std::size_t>{ 0, alphabet.size() - 1 };
+        for (auto i = std::size_t{ 0 }; i < length; ++i) {
+            result += alphabet[distribution(generator)];
+        }
+        return result;
+    }
+} // namespace
+
+TEST(Utf8SearcherTests, FindIn) {
+    auto const searcher = Utf8Searcher{ "Köln"_utf8view };
+    EXPECT_EQ(searcher.needle(), "Köln"_utf8view);
+    EXPECT_EQ(searcher.find_in("Grüße aus Köln und Köln"), 12);
+    EXPECT_EQ(searcher.find_in("Grüße aus Köln und Köln", 13), 22);
+    EXPECT_EQ(searcher.find_in("Grüße aus Bonn"), std::string_view::npos);
+    EXPECT_EQ(searcher.find_in(""), std::string_view::npos);
+    EXPECT_EQ(searcher.find_in("Köln", 5), std::string_view::npos);
+
+    auto const empty = Utf8Searcher{ ""_utf8view };
+    EXPECT_EQ(empty.find_in("abc"), 0);
+    EXPECT_EQ(empty.find_in("abc", 3), 3);
+}
+
+TEST(Utf8SearcherTests, MatchesStringViewFind) {
+    auto generator = std::mt19937{ 42 };
+    for (auto const needle_length : { 1, 2, 3, 7, 16, 31, 63, 64, 65, 100, 200 }) {
+        for (auto i = 0; i < 20; ++i) {
+            auto const needle = random_text(generator, static_cast<std::size_t>(needle_length));
+            auto haystack = random_text(generator, 1000);
+            // make sure that there is at least one match (possibly close to the end)
+            auto const position = std::uniform_int_distribution<std::size_t>{ 0, haystack.size() }(generator);
+            haystack.insert(position, needle);
+            auto const searcher = Utf8Searcher{ Utf8StringView{ needle } };
+            for (auto const start : { std::size_t{ 0 }, std::size_t{ 1 }, position, haystack.size() - 1 }) {
+                ASSERT_EQ(searcher.find_in(haystack, start), std::string_view{ haystack }.find(needle, start))
+                        << "needle: " << needle << ", start: " << start;
+            }
+            auto const view = Utf8StringView{ haystack };
+            auto const found = view.find(Utf8StringView{ needle });
+            ASSERT_EQ(static_cast<std::size_t>(std::distance(view.cbegin(), found)), haystack.find(needle));
+        }
+    }
+}
+
+TEST(Utf8SearcherTests, FindSplitAndReplace) {
+    auto const comma = Utf8Searcher{ ", "_utf8view };
+    auto const haystacks = std::vector{ "Köln, Bonn, Ulm"_utf8, "🌍, 🐸"_utf8, "no delimiter"_utf8 };
+    auto const expected_parts = std::vector<std::vector<Utf8StringView>>{
+        { "Köln", "Bonn", "Ulm" },
+        { "🌍", "🐸" },
+        { "no delimiter" },
+    };
+    for (auto i = std::size_t{ 0 }; i < haystacks.size(); ++i) {
+        EXPECT_EQ(Utf8StringView{ haystacks[i] }.split(comma), expected_parts[i]);
+        EXPECT_EQ(haystacks[i].split(comma).size(), expected_parts[i].size());
+        EXPECT_EQ(haystacks[i].replace(comma, "; "), haystacks[i].replace(", ", "; "));
+    }
+    EXPECT_EQ("Köln, Bonn, Ulm"_utf8.replace(comma, "; ", c2k::MaxReplacementCount{ 1 }), "Köln; Bonn, Ulm");
+
+    auto const bonn = Utf8Searcher{ "Bonn"_utf8view };
+    auto const& cities = haystacks.front();
+    EXPECT_EQ(*cities.find(bonn), 'B');
+    EXPECT_EQ(Utf8StringView{ cities }.find(bonn, cities.cbegin() + 7), cities.cend());
+    EXPECT_EQ(haystacks.back().find(bonn), haystacks.back().cend());
+
+    EXPECT_THROW(std::ignore = "abc"_utf8view.split(Utf8Searcher{ ""_utf8view }), std::invalid_argument);
+}
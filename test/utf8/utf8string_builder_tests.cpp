@@ -0,0 +1,97 @@
+#include <array>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <lib2k/utf8.hpp>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using c2k::Utf8Char;
+using c2k::Utf8String;
+using c2k::Utf8StringBuilder;
+using c2k::Utf8StringView;
+using namespace c2k::Utf8Literals;
+
+TEST(Utf8StringBuilderTests, AppendAndFinish) {
+    auto builder = Utf8StringBuilder{};
+    EXPECT_TRUE(builder.is_empty());
+    EXPECT_EQ(builder.finish(), ""_utf8);
+
+    builder += "Answer: "_utf8view;
+    builder += 42;
+    builder += Utf8Char{ ',' };
+    builder.append(-7LL);
+    builder.append(std::uint8_t{ 255 });
+    builder.append(' ');
+    builder.append(0.1);
+    builder.append(" "_utf8);
+    builder.append(std::numeric_limits<std::int64_t>::min());
+    EXPECT_TRUE(builder.is_ascii());
+
+    auto const expected = "Answer: 42,-7255 0.1 -9223372036854775808"_utf8;
+    auto const result = builder.finish();
+    EXPECT_EQ(result, expected);
+    EXPECT_TRUE(result.is_ascii());
+    EXPECT_EQ(builder.num_bytes(), expected.num_bytes());
+
+    builder += " → 🌍"_utf8view;
+    EXPECT_FALSE(builder.is_ascii());
+    auto const extended = builder.finish();
+    EXPECT_EQ(extended.calculate_char_count(), expected.calculate_char_count() + 4);
+    EXPECT_FALSE(extended.is_ascii());
+}
+
+TEST(Utf8StringBuilderTests, ManyChunks) {
+    auto generator = std::mt19937{ 42 };
+    auto const parts = std::vector{ "a"_utf8view, "ä"_utf8view, "Köln "_utf8view, "🌍🐸"_utf8view };
+    auto builder = Utf8StringBuilder{};
+    auto expected = std::string{};
+    for (auto i = 0; i < 10'000; ++i) {
+        auto const& part = parts[generator() % parts.size()];
+        builder += part;
+        expected += part.view();
+        if (i % 1000 == 0) {
+            // larger than any chunk so far
+            auto const large = std::string(static_cast<std::size_t>(i) * 10 + 5000, 'x');
+            builder += Utf8StringView{ large };
+            expected += large;
+        }
+    }
+    EXPECT_EQ(builder.num_bytes(), expected.size());
+    EXPECT_EQ(builder.finish().view(), expected);
+
+    builder.clear();
+    EXPECT_TRUE(builder.is_empty());
+    EXPECT_TRUE(builder.is_ascii());
+    builder.reserve(100'000);
+    builder += "reused"_utf8view;
+    EXPECT_EQ(builder.finish(), "reused"_utf8);
+}
+
+TEST(Utf8StringBuilderTests, FinishInto) {
+    auto builder = Utf8StringBuilder{};
+    builder += "Grüße "_utf8view;
+    builder += 2024;
+
+    auto buffer = std::array<char, 32>{};
+    auto const view = builder.finish_into(buffer);
+    EXPECT_EQ(view, "Grüße 2024"_utf8view);
+    EXPECT_EQ(view.view().data(), buffer.data());
+
+    auto too_small = std::array<char, 4>{};
+    EXPECT_THROW(std::ignore = builder.finish_into(too_small), std::invalid_argument);
+}
+
+TEST(Utf8StringBuilderTests, JoinAndTransform) {
+    auto const parts = std::vector{ "Köln"_utf8, "Bonn"_utf8, "Ulm"_utf8 };
+    EXPECT_EQ(", "_utf8.join(parts), "Köln, Bonn, Ulm"_utf8);
+    EXPECT_EQ(", "_utf8view.join(parts), "Köln, Bonn, Ulm"_utf8);
+    EXPECT_EQ(", "_utf8.join(std::vector<Utf8String>{}), ""_utf8);
+    EXPECT_TRUE("-"_utf8.join(std::vector{ "a"_utf8, "b"_utf8 }).is_ascii());
+
+    auto const dotted = "Köln"_utf8.transform([](Utf8Char const c) {
+        return c == Utf8Char{ 'l' } ? Utf8Char{ '.' } : c;
+    });
+    EXPECT_EQ(dotted, "Kö.n"_utf8);
+}
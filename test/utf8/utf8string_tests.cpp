@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <array>
 #include <gtest/gtest.h>
 #include <lib2k/utf8.hpp>
+#include <stdexcept>
 #include <unordered_map>
 #include <unordered_set>
 
+using c2k::repeated;
 using c2k::Utf8Char;
 using c2k::Utf8Error;
 using c2k::Utf8String;
@@ -17,6 +20,53 @@ TEST(Utf8StringTests, ValidateUtf8) {
     EXPECT_TRUE(Utf8String::is_valid_utf8("Hey, Ferris! 🦀"));
 }
 
+TEST(Utf8StringTests, ValidateUtf8AcrossBlockBoundaries) {
+    // the validator processes the input in blocks of 64 bytes, so every sequence is tested at every offset
+    // within (and across) the first blocks
+    static constexpr auto valid_sequences = std::array{
+        "\xC2\x80",
+        "\xDF\xBF",
+        "\xE0\xA0\x80",
+        "\xED\x9F\xBF",
+        "\xEE\x80\x80",
+        "\xEF\xBF\xBF",
+        "\xF0\x90\x80\x80",
+        "\xF4\x8F\xBF\xBF",
+        "🦀",
+    };
+    static constexpr auto invalid_sequences = std::array{
+        "\x80",
+        "\xBF",
+        "\xC0\x80",
+        "\xC1\xBF",
+        "\xC2",
+        "\xC2\x41",
+        "\xE0\x80\x80",
+        "\xE0\x9F\xBF",
+        "\xED\xA0\x80",
+        "\xE2\x82",
+        "\xF0\x80\x80\x80",
+        "\xF0\x8F\xBF\xBF",
+        "\xF4\x90\x80\x80",
+        "\xF5\x80\x80\x80",
+        "\xF0\x9F\xA6",
+        "\xFE",
+        "\xFF",
+    };
+    for (auto offset = std::size_t{ 0 }; offset < 140; ++offset) {
+        for (auto const sequence : valid_sequences) {
+            auto const string = std::string(offset, 'a') + sequence + std::string(offset % 7, 'b');
+            EXPECT_TRUE(Utf8String::is_valid_utf8(string)) << "offset " << offset;
+        }
+        for (auto const sequence : invalid_sequences) {
+            auto const string = std::string(offset, 'a') + sequence + std::string(offset % 7, 'b');
+            EXPECT_FALSE(Utf8String::is_valid_utf8(string)) << "offset " << offset;
+            auto const multibyte_prefix = repeated("ä", offset) + sequence;
+            EXPECT_FALSE(Utf8String::is_valid_utf8(multibyte_prefix)) << "offset " << offset;
+        }
+    }
+}
+
 TEST(Utf8StringTests, Construction) {
     EXPECT_TRUE(Utf8String::from_chars("").has_value());
     EXPECT_TRUE(Utf8String::from_chars("abc").has_value());
@@ -51,6 +101,11 @@ TEST(Utf8StringTests, NumChars) {
     EXPECT_EQ(Utf8String::from_chars("🦀🌍😊").value().calculate_char_count(), 3);
     EXPECT_EQ(Utf8String::from_chars("Hello, 🌍!").value().calculate_char_count(), 9);
     EXPECT_EQ(Utf8String::from_chars("C++ Programming 🚀").value().calculate_char_count(), 17);
+    for (auto count = std::size_t{ 0 }; count < 100; ++count) {
+        auto const string = Utf8String{ repeated("aä€🦀", count) + repeated("ö", count % 13) };
+        EXPECT_EQ(string.calculate_char_count(), 4 * count + count % 13) << "count " << count;
+        EXPECT_EQ(c2k::Utf8StringView{ string }.calculate_char_count(), 4 * count + count % 13) << "count " << count;
+    }
 }
 
 TEST(Utf8StringTests, CharWidth) {
@@ -59,6 +114,89 @@ TEST(Utf8StringTests, CharWidth) {
     EXPECT_EQ(Utf8String::from_chars("a🦀c").value().calculate_char_width(), 4);
     EXPECT_EQ(Utf8String::from_chars("🦀🌍😊").value().calculate_char_width(), 6);
     EXPECT_EQ(Utf8String::from_chars("C++ Programming 🚀").value().calculate_char_width(), 18);
+    EXPECT_EQ(Utf8String::from_chars("a\tb\nc\x7F").value().calculate_char_width(), 3);
+    for (auto count = std::size_t{ 0 }; count < 100; ++count) {
+        auto const ascii = Utf8String{ repeated("ab\x01 ", count) };
+        EXPECT_EQ(ascii.calculate_char_width(), 3 * count) << "count " << count;
+        auto const mixed = Utf8String{ repeated("a\t字🦀é", count) + repeated("漢", count % 13) };
+        EXPECT_EQ(mixed.calculate_char_width(), 6 * count + 2 * (count % 13)) << "count " << count;
+    }
+}
+
+TEST(Utf8StringTests, IsAscii) {
+    EXPECT_TRUE(""_utf8.is_ascii());
+    EXPECT_TRUE("abc"_utf8.is_ascii());
+    EXPECT_FALSE("Hello, 🌍!"_utf8.is_ascii());
+    EXPECT_TRUE(Utf8String{ std::string(200, 'x') }.is_ascii());
+    EXPECT_FALSE(Utf8String{ std::string(199, 'x') + "ä" }.is_ascii());
+
+    auto string = "abc"_utf8;
+    string += "def"_utf8;
+    EXPECT_TRUE(string.is_ascii());
+    string += "🦀"_utf8;
+    EXPECT_FALSE(string.is_ascii());
+    EXPECT_EQ(string.calculate_char_count(), 7);
+    EXPECT_EQ(string.back(), *"🦀"_utf8.cbegin());
+    string.clear();
+    EXPECT_TRUE(string.is_ascii());
+    string += 'x'_utf8;
+    EXPECT_TRUE(string.is_ascii());
+    EXPECT_EQ(string.back(), 'x');
+
+    auto const ascii = Utf8String{ "The quick brown fox jumps over the lazy dog." };
+    EXPECT_EQ(ascii.calculate_char_count(), 44);
+    EXPECT_EQ(ascii.substring(4, 5), "quick");
+    EXPECT_EQ(ascii.substring(40), "dog.");
+    EXPECT_EQ(ascii.substring(40, 100), "dog.");
+    EXPECT_EQ(ascii.substring(100), "");
+    EXPECT_EQ(ascii.substring(ascii.cbegin() + 10, 5), "brown");
+    EXPECT_EQ(ascii.find("o", 13), ascii.cbegin() + 17);
+    EXPECT_EQ(ascii.find("o", 100), ascii.cend());
+    EXPECT_TRUE(ascii.substring(4, 5).is_ascii());
+}
+
+TEST(Utf8StringTests, CharIndex) {
+    auto const reference = Utf8String{ repeated("aä🦀€", 100) };
+    auto string = reference;
+    EXPECT_FALSE(string.has_char_index());
+    string.enable_char_index();
+    EXPECT_TRUE(string.has_char_index());
+    EXPECT_EQ(string.calculate_char_count(), 400);
+
+    for (auto i = std::size_t{ 0 }; i <= 402; i += 7) {
+        EXPECT_EQ(string.iterator_at(i), string.cbegin() + static_cast<std::ptrdiff_t>(i)) << "index " << i;
+        EXPECT_EQ(string.char_index_of(string.iterator_at(i)), std::min(i, std::size_t{ 400 })) << "index " << i;
+        EXPECT_EQ(string.substring(i, 13), reference.substring(i, 13)) << "index " << i;
+        EXPECT_EQ(string.find("🦀", static_cast<std::ptrdiff_t>(i)), string.iterator_at(i + (6 - i % 4) % 4))
+                << "index " << i;
+    }
+    EXPECT_EQ(string.distance(string.iterator_at(3), string.iterator_at(250)), 247);
+    EXPECT_EQ(string.substring(396), "aä🦀€");
+    EXPECT_EQ(string.substring(1000), "");
+
+    auto copy = string;
+    EXPECT_TRUE(copy.has_char_index());
+    copy += "xyz";
+    EXPECT_EQ(copy.calculate_char_count(), 403);
+    EXPECT_EQ(copy.substring(399), "€xyz");
+    EXPECT_EQ(string.calculate_char_count(), 400);
+
+    std::ignore = string.erase(string.iterator_at(0), string.iterator_at(2));
+    EXPECT_EQ(string.calculate_char_count(), 398);
+    EXPECT_EQ(string.front(), *"🦀"_utf8.cbegin());
+    EXPECT_EQ(string.substring(396), "🦀€");
+
+    string.reverse();
+    EXPECT_TRUE(string.has_char_index());
+    EXPECT_EQ(string.calculate_char_count(), 398);
+    EXPECT_EQ(string.substring(0, 4), "€🦀äa");
+
+    string.clear();
+    EXPECT_EQ(string.calculate_char_count(), 0);
+    EXPECT_EQ(string.iterator_at(5), string.cend());
+
+    string.disable_char_index();
+    EXPECT_FALSE(string.has_char_index());
 }
 
 TEST(Utf8StringTests, Iterating) {
@@ -367,6 +505,109 @@ TEST(Utf8StringTests, ToLowercase) {
     EXPECT_EQ("THE SYMBOL Φ IS OFTEN USED IN MATH."_utf8.to_lowercase(), "the symbol φ is often used in math.");
 }
 
+TEST(Utf8StringTests, CaseConversionOfLongStrings) {
+    // long ASCII runs are converted in bulk, everything else char by char
+    auto const lowercase = repeated("the quick brown fox jumps over the lazy dog, φ ä 🦀. ", 50);
+    auto const uppercase = repeated("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG, Φ Ä 🦀. ", 50);
+    EXPECT_EQ(Utf8String{ lowercase }.to_uppercase(), Utf8String{ uppercase });
+    EXPECT_EQ(Utf8String{ uppercase }.to_lowercase(), Utf8String{ lowercase });
+    EXPECT_EQ(Utf8String{ repeated("x", 1000) }.to_uppercase(), Utf8String{ repeated("X", 1000) });
+
+    // case mappings that change the number of bytes of a char
+    EXPECT_EQ(Utf8String{ repeated("ıa", 100) }.to_uppercase(), Utf8String{ repeated("IA", 100) });
+    EXPECT_EQ(Utf8String{ repeated("aɐ", 100) }.to_uppercase(), Utf8String{ repeated("AⱯ", 100) });
+    EXPECT_EQ(Utf8String{ repeated("AⱯ", 100) }.to_lowercase(), Utf8String{ repeated("aɐ", 100) });
+}
+
+TEST(Utf8StringTests, InPlaceCaseConversion) {
+    auto string = "Hello, 🌍! The symbol φ is often used in math."_utf8;
+    auto const data = string.c_str();
+    string.make_uppercase();
+    EXPECT_EQ(string, "HELLO, 🌍! THE SYMBOL Φ IS OFTEN USED IN MATH.");
+    string.make_lowercase();
+    EXPECT_EQ(string, "hello, 🌍! the symbol φ is often used in math.");
+    EXPECT_EQ(string.c_str(), data); // no reallocation
+
+    auto ascii = Utf8String{ repeated("abc", 100) };
+    ascii.make_uppercase();
+    EXPECT_EQ(ascii, Utf8String{ repeated("ABC", 100) });
+    EXPECT_TRUE(ascii.is_ascii());
+
+    // shrinking and growing chars
+    auto shrinking = Utf8String{ repeated("ıa", 100) };
+    shrinking.make_uppercase();
+    EXPECT_EQ(shrinking, Utf8String{ repeated("IA", 100) });
+    EXPECT_EQ(shrinking.calculate_char_count(), 200);
+    // the result only consists of ASCII chars
+    EXPECT_TRUE(shrinking.is_ascii());
+    auto growing = Utf8String{ repeated("aɐ", 100) };
+    growing.make_uppercase();
+    EXPECT_EQ(growing, Utf8String{ repeated("AⱯ", 100) });
+    growing.make_lowercase();
+    EXPECT_EQ(growing, Utf8String{ repeated("aɐ", 100) });
+}
+
+TEST(Utf8StringTests, TransformInPlace) {
+    auto string = "a🦀b🦀c"_utf8;
+    auto const data = string.c_str();
+    string.transform_in_place([](Utf8Char const c) { return c == *"🦀"_utf8.cbegin() ? *"ä"_utf8.cbegin() : c; });
+    EXPECT_EQ(string, "aäbäc");
+    EXPECT_EQ(string.c_str(), data);
+    string.transform_in_place([](Utf8Char const c) { return c == 'b' ? *"🌍"_utf8.cbegin() : c; });
+    EXPECT_EQ(string, "aä🌍äc");
+    EXPECT_EQ(string.calculate_char_count(), 5);
+    string.transform_in_place([](Utf8Char const c) { return c.is_lowercase() ? c.to_uppercase() : 'x'_utf8; });
+    EXPECT_EQ(string, "AÄxÄC");
+    string.transform_in_place([](Utf8Char const c) { return c.as_string_view().size() == 1 ? c : '_'_utf8; });
+    EXPECT_EQ(string, "A_x_C");
+    EXPECT_TRUE(string.is_ascii());
+
+    auto empty = ""_utf8;
+    empty.transform_in_place([](Utf8Char) { return 'x'_utf8; });
+    EXPECT_EQ(empty, "");
+
+    // every char grows from one to four bytes
+    auto expanded = Utf8String{ repeated("a", 100) };
+    expanded.transform_in_place([](Utf8Char) { return *"🦀"_utf8.cbegin(); });
+    EXPECT_EQ(expanded, Utf8String{ repeated("🦀", 100) });
+    EXPECT_EQ(expanded.num_bytes(), 400);
+    EXPECT_FALSE(expanded.is_ascii());
+}
+
+TEST(Utf8StringTests, TransformInPlaceWithThrowingTransformer) {
+    // the exception is thrown while the string is rewritten in place
+    auto shrinking = "🦀🦀🦀🦀"_utf8;
+    auto num_calls = 0;
+    auto const throw_on_third_call = [&](Utf8Char) {
+        if (++num_calls == 3) {
+            throw std::runtime_error{ "transformer failed" };
+        }
+        return 'x'_utf8;
+    };
+    EXPECT_THROW(shrinking.transform_in_place(throw_on_third_call), std::runtime_error);
+    EXPECT_EQ(shrinking, "xx🦀🦀");
+    EXPECT_TRUE(Utf8String::is_valid_utf8(shrinking.view()));
+    EXPECT_EQ(shrinking.calculate_char_count(), 4);
+    EXPECT_FALSE(shrinking.is_ascii());
+
+    // the exception is thrown after switching to a new buffer
+    auto growing = "abcd"_utf8;
+    growing.enable_char_index();
+    EXPECT_EQ(growing.substring(3), "d");
+    num_calls = 0;
+    auto const grow_and_throw_on_third_call = [&](Utf8Char) {
+        if (++num_calls == 3) {
+            throw std::runtime_error{ "transformer failed" };
+        }
+        return *"🦀"_utf8.cbegin();
+    };
+    EXPECT_THROW(growing.transform_in_place(grow_and_throw_on_third_call), std::runtime_error);
+    EXPECT_EQ(growing, "🦀🦀cd");
+    EXPECT_FALSE(growing.is_ascii());
+    EXPECT_EQ(growing.substring(3), "d");
+    EXPECT_EQ(growing.calculate_char_count(), 4);
+}
+
 TEST(Utf8StringTests, OutputOperator) {
     auto stream = std::ostringstream{};
     stream << "Hello, 🌍!"_utf8;
@@ -400,6 +641,18 @@ TEST(Utf8StringTests, Substring) {
     EXPECT_EQ(sub, "brown 🦊 jumps over the lazy 🐶."_utf8view);
 }
 
+TEST(Utf8StringTests, SubstringWithOversizedLength) {
+    // the result ends at the end of the string, regardless of its contents and of the char index
+    auto string = "brown 🦊, lazy 🐶"_utf8;
+    EXPECT_EQ(string.substring(6, 100), "🦊, lazy 🐶"_utf8view);
+    EXPECT_EQ(string.substring(string.cbegin() + 6, 100), "🦊, lazy 🐶"_utf8view);
+    EXPECT_EQ(string.substring(100, 100), ""_utf8view);
+    string.enable_char_index();
+    EXPECT_EQ(string.substring(6, 100), "🦊, lazy 🐶"_utf8view);
+    EXPECT_EQ(string.substring(100, 100), ""_utf8view);
+    EXPECT_EQ("brown fox"_utf8.substring(6, 100), "fox"_utf8view);
+}
+
 TEST(Utf8StringTests, FrontAndBack) {
     auto string = ""_utf8;
     EXPECT_THROW(std::ignore = string.front(), std::out_of_range);
@@ -478,6 +731,10 @@ TEST(Utf8StringTests, Replace) {
     EXPECT_EQ("to"_utf8.replace("too long", "something"), "to");
     EXPECT_EQ("abc"_utf8.replace("", "test"), "testatestbtestctest");
     EXPECT_EQ("Bjarne is cool, Scott is cool"_utf8.replace(" is cool", ""), "Bjarne, Scott");
+    EXPECT_EQ("äö🌍"_utf8.replace("", "-"), "-ä-ö-🌍-");
+    EXPECT_EQ("äö🌍"_utf8.replace("", ""), "äö🌍");
+    EXPECT_EQ("🌍🌍🌍"_utf8.replace("🌍", "a"), "aaa");
+    EXPECT_TRUE("🌍🌍🌍"_utf8.replace("🌍", "a").is_ascii());
 
     // with start iterator
     auto view = "aaaa"_utf8;
@@ -530,3 +787,154 @@ TEST(Tf8StringTests, Hashable) {
     EXPECT_EQ(map["three"], 3);
     EXPECT_EQ(map["four"], 4);
 }
+
+TEST(Utf8StringTests, Transcoding) {
+    auto const string = "Hello, wörld! 🌍 ∑ done"_utf8;
+    auto const utf16 = std::u16string{ u"Hello, wörld! 🌍 ∑ done" };
+    auto const utf32 = std::u32string{ U"Hello, wörld! 🌍 ∑ done" };
+    EXPECT_EQ(c2k::utf16_length(string), utf16.size());
+    EXPECT_EQ(c2k::utf32_length(string), utf32.size());
+    EXPECT_EQ(c2k::transcode_to_utf16(string), utf16);
+    EXPECT_EQ(c2k::transcode_to_utf32(string), utf32);
+    EXPECT_EQ(c2k::utf8_length(utf16), string.view().size());
+    EXPECT_EQ(c2k::utf8_length(utf32), string.view().size());
+    EXPECT_EQ(c2k::transcode_from_utf16(utf16), string);
+    EXPECT_EQ(c2k::transcode_from_utf32(utf32), string);
+    EXPECT_EQ(c2k::transcode_to_utf16(""_utf8), u"");
+    EXPECT_EQ(c2k::transcode_from_utf32(U""), ""_utf8);
+
+    // long strings that are mostly ASCII take the vectorized paths
+    auto long_string = Utf8String{};
+    auto long_utf16 = std::u16string{};
+    for (auto i = 0; i < 50; ++i) {
+        long_string += "The quick brown fox jumps over the lazy dog. ";
+        long_utf16 += u"The quick brown fox jumps over the lazy dog. ";
+        if (i % 7 == 0) {
+            long_string += "𝄞é";
+            long_utf16 += u"𝄞é";
+        }
+    }
+    EXPECT_EQ(c2k::transcode_to_utf16(long_string), long_utf16);
+    EXPECT_EQ(c2k::transcode_from_utf16(long_utf16), long_string);
+    EXPECT_EQ(c2k::transcode_from_utf32(c2k::transcode_to_utf32(long_string)), long_string);
+
+    auto buffer16 = std::array<char16_t, 32>{};
+    auto const num_written16 = c2k::transcode_to_utf16("a🌍b"_utf8, buffer16);
+    EXPECT_EQ(std::u16string_view(buffer16.data(), num_written16), u"a🌍b");
+    auto const too_small16 = std::span{ buffer16 }.first(3);
+    EXPECT_THROW(std::ignore = c2k::transcode_to_utf16("a🌍b"_utf8, too_small16), std::length_error);
+    auto buffer32 = std::array<char32_t, 3>{};
+    EXPECT_EQ(c2k::transcode_to_utf32("a🌍b"_utf8, buffer32), 3);
+    EXPECT_EQ(std::u32string_view(buffer32.data(), buffer32.size()), U"a🌍b");
+
+    auto buffer8 = std::array<char, 8>{};
+    EXPECT_EQ(c2k::transcode_from_utf16(u"ä🌍", buffer8), 6);
+    EXPECT_EQ(std::string_view(buffer8.data(), 6), "ä🌍");
+    EXPECT_THROW(std::ignore = c2k::transcode_from_utf16(u"abcdefghi", buffer8), std::length_error);
+    EXPECT_THROW(std::ignore = c2k::transcode_from_utf32(U"abcdef🌍", buffer8), std::length_error);
+
+    auto const lone_high_surrogate = std::u16string{ u'a', char16_t{ 0xD83C }, u'b' };
+    auto const lone_low_surrogate = std::u16string{ char16_t{ 0xDF0D } };
+    auto const truncated_pair = std::u16string{ u'a', char16_t{ 0xD83C } };
+    EXPECT_EQ(c2k::transcode_from_utf16(lone_high_surrogate), tl::unexpected{ Utf8Error::InvalidUtf16String });
+    EXPECT_EQ(c2k::transcode_from_utf16(lone_low_surrogate), tl::unexpected{ Utf8Error::InvalidUtf16String });
+    EXPECT_EQ(c2k::utf8_length(truncated_pair), tl::unexpected{ Utf8Error::InvalidUtf16String });
+    EXPECT_EQ(c2k::transcode_from_utf16(truncated_pair, buffer8), tl::unexpected{ Utf8Error::InvalidUtf16String });
+    auto const surrogate32 = std::u32string{ U'a', char32_t{ 0xD800 } };
+    auto const out_of_range32 = std::u32string{ char32_t{ 0x11'0000 } };
+    EXPECT_EQ(c2k::transcode_from_utf32(surrogate32), tl::unexpected{ Utf8Error::InvalidUtf32String });
+    EXPECT_EQ(c2k::transcode_from_utf32(out_of_range32, buffer8), tl::unexpected{ Utf8Error::InvalidUtf32String });
+}
+
+TEST(Utf8StringTests, LossyConstruction) {
+    using c2k::Utf8ErrorReporting;
+    EXPECT_EQ(Utf8String::from_chars_lossy(""), ""_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("Hello, 🌍!"), "Hello, 🌍!"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("Hello, \xff!"), "Hello, �!"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("\x80"), "�"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("ab\xE0\xA0"), "ab�"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("\xF4\x90\x80\x80"), "����"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("\xED\xA0\x80"), "���"_utf8);
+    EXPECT_EQ(Utf8String::from_chars_lossy("\xE0\xA0\x41"), "�A"_utf8);
+
+    // example from section 3.9 of the Unicode standard (U+FFFD Substitution of Maximal Subparts)
+    auto const chars = std::string{ "\x61\xF1\x80\x80\xE1\x80\xC2\x62\x80\x63\x80\xBF\x64" };
+    auto const expected = "a���b�c��d"_utf8;
+    auto const all_errors = Utf8String::from_chars_lossy(chars, Utf8ErrorReporting::AllErrors);
+    EXPECT_EQ(all_errors.string, expected);
+    EXPECT_EQ(all_errors.error_offsets, (std::vector<std::size_t>{ 1, 4, 6, 8, 10, 11 }));
+    auto const first_error = Utf8String::from_chars_lossy(chars, Utf8ErrorReporting::FirstError);
+    EXPECT_EQ(first_error.string, expected);
+    EXPECT_EQ(first_error.error_offsets, (std::vector<std::size_t>{ 1 }));
+    EXPECT_TRUE(Utf8String::from_chars_lossy("valid", Utf8ErrorReporting::AllErrors).error_offsets.empty());
+
+    // errors in and after long runs of ASCII and multibyte characters
+    auto long_chars = std::string{};
+    auto long_expected = Utf8String{};
+    auto expected_offsets = std::vector<std::size_t>{};
+    for (auto i = 0; i < 20; ++i) {
+        long_chars += "some ASCII text, ä and 🌍";
+        long_expected += "some ASCII text, ä and 🌍";
+        expected_offsets.push_back(long_chars.size());
+        long_chars += (i % 2 == 0 ? "\xC3" : "\xF0\x9F\x8C");
+        long_expected += "�";
+    }
+    auto const repaired = Utf8String::from_chars_lossy(long_chars, Utf8ErrorReporting::AllErrors);
+    EXPECT_EQ(repaired.string, long_expected);
+    EXPECT_EQ(repaired.error_offsets, expected_offsets);
+
+    // the repaired string is built in the buffer of the input if it is large enough
+    auto buffer = std::string{ "x\xFFy" };
+    buffer.reserve(100);
+    auto const data = buffer.data();
+    auto const in_place = Utf8String::from_chars_lossy(std::move(buffer));
+    EXPECT_EQ(in_place, "x�y"_utf8);
+    EXPECT_EQ(in_place.view().data(), data);
+}
+
+TEST(Utf8StringTests, StreamValidation) {
+    auto const text =
+            std::string{ "Hello, wörld! 🌍 ∑ \xF4\x8F\xBF\xBF and some more ASCII text to fill a SIMD register" };
+    for (auto chunk_size = std::size_t{ 1 }; chunk_size <= 9; ++chunk_size) {
+        auto validator = c2k::Utf8StreamValidator{};
+        auto num_complete_bytes = std::size_t{ 0 };
+        for (auto offset = std::size_t{ 0 }; offset < text.size(); offset += chunk_size) {
+            auto const chunk = std::string_view{ text }.substr(offset, chunk_size);
+            auto const result = validator.feed(chunk);
+            ASSERT_TRUE(result.has_value()) << "chunk size " << chunk_size << ", offset " << offset;
+            EXPECT_LE(result.value(), chunk.size());
+            num_complete_bytes = validator.num_complete_bytes();
+            EXPECT_EQ(num_complete_bytes + validator.num_pending_bytes(), offset + chunk.size());
+            EXPECT_TRUE(Utf8String::is_valid_utf8(std::string_view{ text }.substr(0, num_complete_bytes)));
+        }
+        EXPECT_EQ(num_complete_bytes, text.size());
+        EXPECT_TRUE(validator.finish().has_value());
+    }
+
+    auto validator = c2k::Utf8StreamValidator{};
+    EXPECT_EQ(validator.feed("ab\xF0\x9F"), 2);
+    EXPECT_EQ(validator.num_pending_bytes(), 2);
+    EXPECT_EQ(validator.feed("\x8C"), 0);
+    EXPECT_FALSE(validator.finish().has_value());
+    EXPECT_EQ(validator.feed("\x8D!"), 2);
+    EXPECT_EQ(validator.num_complete_bytes(), 7);
+    EXPECT_TRUE(validator.finish().has_value());
+
+    auto const invalid_streams = std::array<std::array<std::string_view, 2>, 6>{
+        std::array<std::string_view, 2>{ "abc\xC3", "x" },
+        { "\xE0", "\x80\x80" },
+        { "\xED\xA0", "\x80" },
+        { "\xF4\x90", "\x80\x80" },
+        { "abc", "\xFF" },
+        { "\xF0\x9F", "\x8C\x8D\x80" },
+    };
+    for (auto const& [first, second] : invalid_streams) {
+        validator.reset();
+        auto const first_result = validator.feed(first);
+        auto const second_result = first_result.and_then([&](std::size_t) { return validator.feed(second); });
+        EXPECT_EQ(second_result, tl::unexpected{ Utf8Error::InvalidUtf8String }) << first;
+        // errors are sticky
+        EXPECT_EQ(validator.feed("abc"), tl::unexpected{ Utf8Error::InvalidUtf8String });
+        EXPECT_FALSE(validator.finish().has_value());
+    }
+}
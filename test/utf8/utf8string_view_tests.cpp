@@ -3,6 +3,7 @@
 #include <lib2k/utf8.hpp>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 using c2k::Utf8Char;
@@ -55,6 +56,133 @@ TEST(Utf8StringViewTests, CharWidth) {
     EXPECT_EQ("C++ Programming 🚀"_utf8view.calculate_char_width(), 18);
 }
 
+namespace {
+    template<typename T>
+    concept NormalizableAs = requires(T&& string) { std::forward<T>(string).normalized(c2k::NormalizationForm::Nfc); };
+} // namespace
+
+TEST(Utf8StringViewTests, Normalization) {
+    // the result may refer to the input, so temporary strings cannot be normalized
+    static_assert(NormalizableAs<Utf8String const&>);
+    static_assert(not NormalizableAs<Utf8String>);
+    static_assert(NormalizableAs<Utf8StringView>);
+
+    using c2k::NormalizationForm;
+    auto const composed = "Caf\u00E9"_utf8view;
+    auto const decomposed = "Cafe\u0301"_utf8view;
+    EXPECT_NE(composed, decomposed);
+    EXPECT_TRUE(composed.is_normalized(NormalizationForm::Nfc));
+    EXPECT_FALSE(composed.is_normalized(NormalizationForm::Nfd));
+    EXPECT_FALSE(decomposed.is_normalized(NormalizationForm::Nfc));
+    EXPECT_TRUE(decomposed.is_normalized(NormalizationForm::Nfd));
+    EXPECT_EQ(decomposed.normalized(NormalizationForm::Nfc).view(), composed);
+    EXPECT_EQ(composed.normalized(NormalizationForm::Nfd).view(), decomposed);
+
+    // already normalized input is returned without a copy
+    auto const unchanged = composed.normalized(NormalizationForm::Nfc);
+    EXPECT_TRUE(unchanged.was_normalized());
+    EXPECT_EQ(unchanged.view().view().data(), composed.view().data());
+    EXPECT_TRUE("plain ASCII"_utf8view.normalized(NormalizationForm::Nfkd).was_normalized());
+    EXPECT_FALSE(decomposed.normalized(NormalizationForm::Nfc).was_normalized());
+
+    // singletons and canonical ordering of combining marks
+    EXPECT_EQ("\u2126"_utf8view.normalized(NormalizationForm::Nfc).view(), "\u03A9"_utf8view);
+    EXPECT_EQ("\u212B"_utf8view.normalized(NormalizationForm::Nfc).view(), "\u00C5"_utf8view);
+    EXPECT_FALSE("s\u0307\u0323"_utf8view.is_normalized(NormalizationForm::Nfd));
+    EXPECT_EQ("s\u0307\u0323"_utf8view.normalized(NormalizationForm::Nfd).view(), "s\u0323\u0307"_utf8view);
+    EXPECT_EQ("s\u0307\u0323"_utf8view.normalized(NormalizationForm::Nfc).view(), "\u1E69"_utf8view);
+
+    // compatibility decompositions
+    EXPECT_TRUE("\uFB01x\u00B2"_utf8view.is_normalized(NormalizationForm::Nfc));
+    EXPECT_FALSE("\uFB01x\u00B2"_utf8view.is_normalized(NormalizationForm::Nfkc));
+    EXPECT_EQ("\uFB01x\u00B2"_utf8view.normalized(NormalizationForm::Nfkc).to_string(), "fix2"_utf8);
+
+    auto string = c2k::Utf8String{ decomposed };
+    string.normalize(NormalizationForm::Nfc);
+    EXPECT_EQ(string, composed);
+    EXPECT_EQ(string.calculate_char_count(), 4);
+}
+
+TEST(Utf8StringViewTests, CaseInsensitiveComparison) {
+    EXPECT_TRUE("Hello, World!"_utf8view.equals_ignore_case("hELLO, wORLD!"));
+    EXPECT_FALSE("Hello, World!"_utf8view.equals_ignore_case("Hello, World"));
+    EXPECT_FALSE("Hello"_utf8view.equals_ignore_case("Hallo"));
+    EXPECT_TRUE(""_utf8view.equals_ignore_case(""));
+    EXPECT_TRUE("Ärger über Öl"_utf8view.equals_ignore_case("äRGER ÜBER öL"));
+    // the final sigma folds to the regular one
+    EXPECT_TRUE("ΣΟΦΟΣ"_utf8view.equals_ignore_case("σοφο\u03C2"));
+    // the Kelvin sign folds to an ASCII letter
+    EXPECT_TRUE("\u212A"_utf8view.equals_ignore_case("k"));
+    // simple case folding: 'ẞ' folds to 'ß', but neither expands, and 'İ' only folds to itself
+    EXPECT_TRUE("\u1E9E"_utf8view.equals_ignore_case("ß"));
+    // for these, the simple case folding is not the lowercase mapping
+    EXPECT_TRUE("\u1FD3"_utf8view.equals_ignore_case("\u0390"));
+    EXPECT_TRUE("\u1FE3"_utf8view.equals_ignore_case("\u03B0"));
+    EXPECT_TRUE("\uFB05"_utf8view.equals_ignore_case("\uFB06"));
+    EXPECT_FALSE("\uFB05"_utf8view.equals_ignore_case("st"));
+    EXPECT_FALSE("ß"_utf8view.equals_ignore_case("ss"));
+    EXPECT_FALSE("\u0130"_utf8view.equals_ignore_case("i"));
+    EXPECT_TRUE("\u0130"_utf8view.equals_ignore_case("\u0130"));
+    EXPECT_TRUE("\u1F88"_utf8view.equals_ignore_case("\u1F80"));
+    EXPECT_FALSE("@"_utf8view.equals_ignore_case("`"));
+    EXPECT_FALSE("["_utf8view.equals_ignore_case("{"));
+
+    EXPECT_EQ("apple"_utf8view.compare_ignore_case("BANANA"), std::weak_ordering::less);
+    EXPECT_EQ("Cherry"_utf8view.compare_ignore_case("banana"), std::weak_ordering::greater);
+    EXPECT_EQ("Straße"_utf8view.compare_ignore_case("STRASSE"), std::weak_ordering::greater);
+    EXPECT_EQ("ab"_utf8view.compare_ignore_case("ABC"), std::weak_ordering::less);
+    EXPECT_EQ("Ölfass"_utf8view.compare_ignore_case("öLFASS"), std::weak_ordering::equivalent);
+
+    auto const long_lowercase = c2k::repeated("the quick brown fox jumps over the lazy dog äöü ", 20);
+    auto const long_uppercase = c2k::repeated("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG ÄÖÜ ", 20);
+    EXPECT_TRUE(Utf8StringView{ long_lowercase }.equals_ignore_case(long_uppercase));
+    EXPECT_EQ(Utf8StringView{ long_lowercase }.compare_ignore_case(long_uppercase + "!"), std::weak_ordering::less);
+}
+
+TEST(Utf8StringViewTests, CaseInsensitiveHashing) {
+    auto const hash = c2k::CaseInsensitiveHash{};
+    EXPECT_EQ(hash("Hello, World!"), hash("hello, world!"));
+    EXPECT_EQ(hash("ÄRGER"), hash("ärger"));
+    EXPECT_EQ(hash("\u212Aelvin"), hash("kelvin"));
+    auto const long_lowercase = c2k::repeated("the quick brown fox jumps over the lazy dog äöü ", 20);
+    auto const long_uppercase = c2k::repeated("THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG ÄÖÜ ", 20);
+    EXPECT_EQ(hash(long_lowercase), hash(long_uppercase));
+    EXPECT_EQ(hash("\u212A" + long_lowercase), hash("k" + long_lowercase));
+
+    auto map = std::unordered_map<Utf8String, int, c2k::CaseInsensitiveHash, c2k::CaseInsensitiveEqual>{};
+    map["Content-Type"_utf8] = 1;
+    map["Ölpreis"_utf8] = 2;
+    EXPECT_EQ(map.size(), 2);
+    ASSERT_TRUE(map.contains("content-type"_utf8view));
+    EXPECT_EQ(map.find("CONTENT-TYPE"_utf8view)->second, 1);
+    EXPECT_EQ(map.find("ÖLPREIS"_utf8view)->second, 2);
+    EXPECT_FALSE(map.contains("Content-Length"_utf8view));
+    map["content-TYPE"_utf8] = 3;
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(Utf8StringViewTests, IsAscii) {
+    EXPECT_TRUE(""_utf8view.is_ascii());
+    EXPECT_TRUE("abc"_utf8view.is_ascii());
+    EXPECT_FALSE("Hello, 🌍!"_utf8view.is_ascii());
+    EXPECT_TRUE(Utf8StringView{ "abc"_utf8 }.is_ascii());
+    EXPECT_FALSE(Utf8StringView{ "a🦀c"_utf8 }.is_ascii());
+
+    auto const string = "The quick brown 🦊 jumps over the lazy 🐶."_utf8;
+    auto const view = Utf8StringView{ string };
+    EXPECT_TRUE(view.substring(4, 5).is_ascii());
+    EXPECT_FALSE(view.substring(10, 7).is_ascii());
+
+    auto const ascii = "The quick brown fox jumps over the lazy dog."_utf8view;
+    EXPECT_EQ(ascii.calculate_char_count(), 44);
+    EXPECT_EQ(ascii.substring(4, 5), "quick"_utf8view);
+    EXPECT_EQ(ascii.substring(4, 5).calculate_char_count(), 5);
+    EXPECT_EQ(ascii.substring(40, 100), "dog."_utf8view);
+    EXPECT_EQ(ascii.substring(100), ""_utf8view);
+    EXPECT_EQ(ascii.back(), '.');
+    EXPECT_EQ(ascii.find("o"_utf8view, 13), ascii.cbegin() + 17);
+}
+
 TEST(Utf8StringViewTests, Iterating) {
     auto const utf8_string_view = "Hello, 🌍!"_utf8view;
     auto iterator = utf8_string_view.begin();
@@ -227,6 +355,17 @@ TEST(Utf8StringViewTests, Substring) {
     EXPECT_EQ(sub, "brown 🦊 jumps over the lazy 🐶."_utf8view);
 }
 
+TEST(Utf8StringViewTests, SubstringWithOversizedLength) {
+    // the view does not end with a null terminator that would stop the iteration
+    auto const data = std::string{ "brown 🦊, lazy 🐶 and more" };
+    auto const string = Utf8StringView{ std::string_view{ data }.substr(0, data.find(" and")) };
+    EXPECT_EQ(string.substring(6, 100), "🦊, lazy 🐶"_utf8view);
+    EXPECT_EQ(string.substring(string.cbegin() + 6, 100), "🦊, lazy 🐶"_utf8view);
+    EXPECT_EQ(string.substring(100, 100), ""_utf8view);
+    EXPECT_EQ(string.find(Utf8Char{ 'x' }, 100), string.cend());
+    EXPECT_EQ("brown fox"_utf8view.substring(6, 100), "fox"_utf8view);
+}
+
 TEST(Utf8StringViewTests, FrontAndBack) {
     auto string = ""_utf8view;
     EXPECT_THROW(std::ignore = string.front(), std::out_of_range);
@@ -304,6 +443,53 @@ TEST(Utf8StringViewTests, Split) {
     );
 }
 
+TEST(Utf8StringViewTests, SplitView) {
+    for (auto const text : { "one;two;three"_utf8view, ""_utf8view, ";;"_utf8view, "Köln;🌍;Ulm;"_utf8view }) {
+        auto parts = std::vector<Utf8StringView>{};
+        for (auto const part : text.split_view(";")) {
+            parts.push_back(part);
+        }
+        EXPECT_EQ(parts, text.split(";"));
+    }
+
+    auto const string = "Grüße 🌍 aus 🌍 Köln"_utf8;
+    auto const parts = string.split_view(" 🌍 ");
+    EXPECT_EQ(*parts.begin(), "Grüße"_utf8view);
+    EXPECT_EQ(std::ranges::distance(parts), 3);
+    EXPECT_EQ(parts.front().calculate_char_count(), 5);
+    EXPECT_THROW(std::ignore = string.split_view(""), std::invalid_argument);
+
+    auto result = std::vector<Utf8StringView>{ "old"_utf8view };
+    string.split_into(" 🌍 ", result);
+    EXPECT_EQ(result, (std::vector{ "Grüße"_utf8view, "aus"_utf8view, "Köln"_utf8view }));
+    "a-b"_utf8view.split_into(c2k::Utf8Searcher{ "-"_utf8view }, result);
+    EXPECT_EQ(result, (std::vector{ "a"_utf8view, "b"_utf8view }));
+}
+
+TEST(Utf8StringViewTests, Tokenize) {
+    // multi-byte delimiters: U+3001 (ideographic comma) and U+3002 (ideographic full stop)
+    auto const delimiters = " ,、。"_utf8view;
+    auto const text = "東京、大阪。 名古屋, 札幌、、ŁÓDŹ"_utf8;
+    auto tokens = std::vector<Utf8StringView>{};
+    for (auto const token : text.tokenize(delimiters)) {
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(
+            tokens,
+            (std::vector{ "東京"_utf8view, "大阪"_utf8view, "名古屋"_utf8view, "札幌"_utf8view, "ŁÓDŹ"_utf8view })
+    );
+    EXPECT_EQ(tokens.back().calculate_char_count(), 4);
+
+    auto spans = std::vector<c2k::TokenSpan>{};
+    "a、b"_utf8view.tokenize_into(delimiters, spans);
+    EXPECT_EQ(spans, (std::vector<c2k::TokenSpan>{ { 0, 1 }, { 4, 1 } }));
+    "、、"_utf8view.tokenize_into(delimiters, spans);
+    EXPECT_TRUE(spans.empty());
+
+    // same lead byte (0xE3) as the delimiters, but no delimiter
+    EXPECT_EQ(std::ranges::distance("ひらがな"_utf8view.tokenize(delimiters)), 1);
+}
+
 TEST(Utf8StringViewTests, Replace) {
     using namespace c2k::Utf8Literals;
     using c2k::MaxReplacementCount;